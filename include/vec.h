@@ -33,9 +33,15 @@ SOFTWARE. */
 #ifndef vec_malloc
 #define vec_malloc  malloc
 #endif
+#ifndef vec_calloc
+#define vec_calloc  calloc
+#endif
 #ifndef vec_realloc
 #define vec_realloc realloc
 #endif
+#ifndef vec_aligned_alloc
+#define vec_aligned_alloc aligned_alloc
+#endif
 #ifndef vec_memset
 #define vec_memset  memset
 #endif
@@ -45,6 +51,14 @@ SOFTWARE. */
 #ifndef vec_memmove
 #define vec_memmove memmove
 #endif
+#ifndef vec_free
+#define vec_free    free
+#endif
+
+/* size of a cache line, to keep data of different threads apart */
+#ifndef VEC_CACHE_LINE
+#define VEC_CACHE_LINE  64
+#endif
 
 #undef  VEC_DEFAULT_SIZE
 #ifdef  VEC_SETTINGS_DEFAULT_SIZE
@@ -67,6 +81,98 @@ SOFTWARE. */
 #define VEC_KEEP_ZERO_END 0
 #endif
 
+#undef  VEC_ZERO_INIT
+#ifdef  VEC_SETTINGS_ZERO_INIT
+#define VEC_ZERO_INIT VEC_SETTINGS_ZERO_INIT
+#else
+#define VEC_ZERO_INIT 1
+#endif
+
+#undef  VEC_ALIGN
+#undef  VEC_ALIGNAS
+#ifdef  VEC_SETTINGS_ALIGN
+#define VEC_ALIGN VEC_SETTINGS_ALIGN
+#define VEC_ALIGNAS _Alignas(VEC_ALIGN)
+#else
+#define VEC_ALIGN 0
+#define VEC_ALIGNAS
+#endif
+
+#undef  VEC_ALLOCATOR
+#ifdef  VEC_SETTINGS_ALLOCATOR
+#define VEC_ALLOCATOR VEC_SETTINGS_ALLOCATOR
+#else
+#define VEC_ALLOCATOR 0
+#endif
+
+#undef  VEC_GROWTH
+#ifdef  VEC_SETTINGS_GROWTH
+#define VEC_GROWTH VEC_SETTINGS_GROWTH
+#else
+#define VEC_GROWTH vec_growth_double
+#endif
+
+#undef  VEC_GROWTH_PARAM
+#ifdef  VEC_SETTINGS_GROWTH_PARAM
+#define VEC_GROWTH_PARAM VEC_SETTINGS_GROWTH_PARAM
+#else
+#define VEC_GROWTH_PARAM 0
+#endif
+
+#undef  VEC_MREMAP_THRESHOLD
+#ifdef  VEC_SETTINGS_MREMAP_THRESHOLD
+#define VEC_MREMAP_THRESHOLD VEC_SETTINGS_MREMAP_THRESHOLD
+#else
+#define VEC_MREMAP_THRESHOLD 0
+#endif
+
+#undef  VEC_HUGEPAGE_THRESHOLD
+#ifdef  VEC_SETTINGS_HUGEPAGE_THRESHOLD
+#define VEC_HUGEPAGE_THRESHOLD VEC_SETTINGS_HUGEPAGE_THRESHOLD
+#else
+#define VEC_HUGEPAGE_THRESHOLD 0
+#endif
+
+#undef  VEC_STATS
+#ifdef  VEC_SETTINGS_STATS
+#define VEC_STATS VEC_SETTINGS_STATS
+#else
+#define VEC_STATS 0
+#endif
+
+#undef  VEC_COMPACT_FRONT
+#ifdef  VEC_SETTINGS_COMPACT_FRONT
+#define VEC_COMPACT_FRONT VEC_SETTINGS_COMPACT_FRONT
+#else
+#define VEC_COMPACT_FRONT 0
+#endif
+
+#undef  VEC_SHRINK_LOW
+#ifdef  VEC_SETTINGS_SHRINK_LOW
+#define VEC_SHRINK_LOW VEC_SETTINGS_SHRINK_LOW
+#else
+#define VEC_SHRINK_LOW 0
+#endif
+
+#undef  VEC_INLINE_CAP
+#undef  VEC_STRUCT_INLINE_BY_VAL
+#undef  VEC_INLINE_ITEMS_BY_VAL
+#ifdef  VEC_SETTINGS_INLINE_CAP
+#define VEC_INLINE_CAP VEC_SETTINGS_INLINE_CAP
+#define VEC_STRUCT_INLINE_BY_VAL(T)     VEC_ALIGNAS T inline_items[VEC_INLINE_CAP];
+#define VEC_INLINE_ITEMS_BY_VAL(vec)    ((vec)->inline_items)
+#else
+#define VEC_INLINE_CAP 0
+#define VEC_STRUCT_INLINE_BY_VAL(T)
+#define VEC_INLINE_ITEMS_BY_VAL(vec)    0
+#endif
+
+#undef  VEC_SLAB
+#ifdef  VEC_SETTINGS_SLAB
+#define VEC_SLAB VEC_SETTINGS_SLAB
+#else
+#define VEC_SLAB 0
+#endif
 
 #ifndef VEC_H
 
@@ -83,6 +189,54 @@ typedef enum
     VEC_ERROR__COUNT,
 } VecErrorList;
 
+/*
+ * === THE ALLOCATOR DESCRIPTION ===
+ * alloc - allocate size bytes
+ * realloc - resize ptr from size_old to size_new bytes
+ * free - release ptr, which was size bytes large
+ * user - passed as first argument to each of the above
+ */
+typedef struct VecAllocator {
+    void *(*alloc)(void *user, size_t size);
+    void *(*realloc)(void *user, void *ptr, size_t size_old, size_t size_new);
+    void (*free)(void *user, void *ptr, size_t size);
+    void *user;
+} VecAllocator;
+
+/*
+ * === THE SLAB DESCRIPTION ===
+ * next - previously allocated slab
+ * size - size of this slab in bytes (including this header)
+ * bodies - the item bodies carved from this slab
+ */
+typedef struct VecSlab {
+    struct VecSlab *next;
+    size_t size;
+    max_align_t bodies[];
+} VecSlab;
+
+/* counters of one instantiation, kept if VEC_SETTINGS_STATS is set */
+typedef struct VecStats {
+    size_t allocs;          /* fresh allocations */
+    size_t reallocs;        /* reallocations */
+    size_t frees;           /* freed allocations */
+    size_t bytes_copied;    /* bytes copied between allocations (including reallocs that moved) */
+    size_t memmoves;        /* shifts of items within an allocation */
+    size_t bytes_moved;     /* bytes shifted within an allocation */
+    size_t peak_cap;        /* highest capacity reserved, in items */
+    size_t shrinks;         /* capacity reductions */
+} VecStats;
+
+#define VEC_STATS_ADD(A, field, n)  do { if(VEC_STATS) A##_static_stats.field += (n); } while(0)
+#define VEC_STATS_PEAK(A, cap)      do { if(VEC_STATS && (cap) > A##_static_stats.peak_cap) A##_static_stats.peak_cap = (cap); } while(0)
+
+static inline void vec_stats_print(FILE *file, const char *name, const VecStats *stats)
+{
+    fprintf(file, "%s: allocs %zu, reallocs %zu, frees %zu, copied %zu bytes, memmoves %zu (%zu bytes), peak cap %zu, shrinks %zu\n",
+            name, stats->allocs, stats->reallocs, stats->frees, stats->bytes_copied,
+            stats->memmoves, stats->bytes_moved, stats->peak_cap, stats->shrinks);
+}
+
 #define VEC_ITEM_BY_VAL(T)  T
 #define VEC_ITEM_BY_REF(T)  T *
 #define VEC_ITEM(T, M)  VEC_ITEM_##M(T)
@@ -91,16 +245,303 @@ typedef enum
 #define VEC_REF_BY_REF
 #define VEC_REF(M)       VEC_REF_##M
 
-#define VEC_ASSERT_REAL(x)      assert(x && "assertion failed")
+#define VEC_ASSERT_REAL(x)      assert((x) && "assertion failed")
 
 #define VEC_ASSERT_BY_REF(x)    VEC_ASSERT_REAL(x)
 #define VEC_ASSERT_BY_VAL(x)
 #define VEC_ASSERT(x, M)        VEC_ASSERT_##M(x)
 
+/*
+ * === THE MAPPED MEMORY ===
+ * large buffers can be backed by anonymous mappings, so that growing them
+ * is done by remapping pages instead of copying
+ */
+
+#if defined(__linux__)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS 0x20
+#endif
+#ifndef MREMAP_MAYMOVE
+#define MREMAP_MAYMOVE 1
+extern void *mremap(void *old_address, size_t old_size, size_t new_size, int flags, ...);
+#endif
+#ifndef MREMAP_FIXED
+#define MREMAP_FIXED 2
+#endif
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE 14
+extern int madvise(void *addr, size_t length, int advice);
+#endif
+
+#define VEC_MMAP_AVAILABLE 1
+
+/* size of a mapping holding size bytes */
+static inline size_t vec_mmap_size(size_t size)
+{
+    static size_t page = 0;
+    if(!page) page = (size_t)sysconf(_SC_PAGESIZE);
+    return ((size + page - 1) / page) * page;
+}
+
+static inline void *vec_mmap_alloc(size_t size)
+{
+    void *ptr = mmap(0, vec_mmap_size(size), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? 0 : ptr;
+}
+
+static inline void *vec_mmap_realloc(void *ptr, size_t size_old, size_t size_new)
+{
+    size_t map_old = vec_mmap_size(size_old);
+    size_t map_new = vec_mmap_size(size_new);
+    if(map_old == map_new) return ptr;
+    void *result = mremap(ptr, map_old, map_new, MREMAP_MAYMOVE);
+    return result == MAP_FAILED ? 0 : result;
+}
+
+static inline void vec_mmap_free(void *ptr, size_t size)
+{
+    if(ptr) munmap(ptr, vec_mmap_size(size));
+}
+
+#define VEC_HUGE_PAGE   ((size_t)1 << 21)
+
+/* size of a huge page aligned mapping holding size bytes */
+static inline size_t vec_huge_size(size_t size)
+{
+    return ((size + VEC_HUGE_PAGE - 1) / VEC_HUGE_PAGE) * VEC_HUGE_PAGE;
+}
+
+/* map size bytes at a huge page boundary, by over-mapping and trimming the excess */
+static inline void *vec_huge_map(size_t size)
+{
+    size_t map = vec_huge_size(size);
+    unsigned char *ptr = mmap(0, map + VEC_HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(ptr == MAP_FAILED) return 0;
+    size_t head = (VEC_HUGE_PAGE - (uintptr_t)ptr % VEC_HUGE_PAGE) % VEC_HUGE_PAGE;
+    if(head) munmap(ptr, head);
+    munmap(ptr + head + map, VEC_HUGE_PAGE - head);
+    return ptr + head;
+}
+
+static inline void *vec_huge_alloc(size_t size)
+{
+    void *ptr = vec_huge_map(size);
+    if(ptr) madvise(ptr, vec_huge_size(size), MADV_HUGEPAGE);
+    return ptr;
+}
+
+static inline void *vec_huge_realloc(void *ptr, size_t size_old, size_t size_new)
+{
+    size_t map_old = vec_huge_size(size_old);
+    size_t map_new = vec_huge_size(size_new);
+    if(map_old == map_new) return ptr;
+    /* shrinking, or growing in place, keeps the alignment */
+    void *result = mremap(ptr, map_old, map_new, 0);
+    if(result == MAP_FAILED) {
+        /* otherwise move the pages to a freshly reserved aligned spot */
+        void *dest = vec_huge_map(size_new);
+        if(!dest) return 0;
+        result = mremap(ptr, map_old, map_new, MREMAP_MAYMOVE | MREMAP_FIXED, dest);
+        if(result == MAP_FAILED) {
+            munmap(dest, map_new);
+            return 0;
+        }
+    }
+    if(map_new > map_old) madvise(result, map_new, MADV_HUGEPAGE);
+    return result;
+}
+
+static inline void vec_huge_free(void *ptr, size_t size)
+{
+    if(ptr) munmap(ptr, vec_huge_size(size));
+}
+
+#else
+
+#define VEC_MMAP_AVAILABLE 0
+
+static inline size_t vec_mmap_size(size_t size) { return size; }
+static inline void *vec_mmap_alloc(size_t size) { (void) size; return 0; }
+static inline void *vec_mmap_realloc(void *ptr, size_t size_old, size_t size_new) { (void) ptr; (void) size_old; (void) size_new; return 0; }
+static inline void vec_mmap_free(void *ptr, size_t size) { (void) ptr; (void) size; }
+
+static inline size_t vec_huge_size(size_t size) { return size; }
+static inline void *vec_huge_alloc(size_t size) { (void) size; return 0; }
+static inline void *vec_huge_realloc(void *ptr, size_t size_old, size_t size_new) { (void) ptr; (void) size_old; (void) size_new; return 0; }
+static inline void vec_huge_free(void *ptr, size_t size) { (void) ptr; (void) size; }
+
+#endif
+
+/* kinds of mapped memory, see A##_static_mapped */
+typedef enum {
+    VEC_MAPPED_NONE,
+    VEC_MAPPED_PAGES,
+    VEC_MAPPED_HUGE,
+} VecMapped;
+
+static inline size_t vec_mapped_size(VecMapped mapped, size_t size)
+{
+    return mapped == VEC_MAPPED_HUGE ? vec_huge_size(size) : vec_mmap_size(size);
+}
+
+static inline void *vec_mapped_alloc(VecMapped mapped, size_t size)
+{
+    return mapped == VEC_MAPPED_HUGE ? vec_huge_alloc(size) : vec_mmap_alloc(size);
+}
+
+static inline void *vec_mapped_realloc(VecMapped mapped, void *ptr, size_t size_old, size_t size_new)
+{
+    return mapped == VEC_MAPPED_HUGE ? vec_huge_realloc(ptr, size_old, size_new) : vec_mmap_realloc(ptr, size_old, size_new);
+}
+
+static inline void vec_mapped_free(VecMapped mapped, void *ptr, size_t size)
+{
+    if(mapped == VEC_MAPPED_HUGE) vec_huge_free(ptr, size);
+    else vec_mmap_free(ptr, size);
+}
+
+/* allocate memory from the heap, aligned if align is non-zero (then size has to be a multiple of it) */
+static inline void *vec_heap_alloc(size_t align, size_t size)
+{
+    if(!align) return vec_malloc(size);
+    return vec_aligned_alloc(align, size);
+}
+
+/*
+ * === THE GROWTH POLICIES ===
+ * cap - current capacity in items, never zero
+ * required - the minimum capacity in items, larger than cap
+ * size - size of one item in bytes
+ * param - VEC_SETTINGS_GROWTH_PARAM, zero picks a default
+ * return a capacity in items of at least required
+ */
+
+/* double the capacity */
+static inline size_t vec_growth_double(size_t cap, size_t required, size_t size, size_t param)
+{
+    (void) size;
+    (void) param;
+    while(cap < required) cap *= 2;
+    return cap;
+}
+
+/* grow the capacity by 1.5 */
+static inline size_t vec_growth_1_5(size_t cap, size_t required, size_t size, size_t param)
+{
+    (void) size;
+    (void) param;
+    while(cap < required) cap += cap / 2 + 1;
+    return cap;
+}
+
+/* grow the capacity by the golden ratio (approximated by (144 + 89) / 144) */
+static inline size_t vec_growth_golden(size_t cap, size_t required, size_t size, size_t param)
+{
+    (void) size;
+    (void) param;
+    while(cap < required) cap += (cap / 144) * 89 + ((cap % 144) * 89) / 144 + 1;
+    return cap;
+}
+
+/* grow the capacity by param items (default 64) */
+static inline size_t vec_growth_fixed(size_t cap, size_t required, size_t size, size_t param)
+{
+    (void) size;
+    if(!param) param = 64;
+    return cap + ((required - cap + param - 1) / param) * param;
+}
+
+/* grow the capacity to the next multiple of param bytes (default 4096) */
+static inline size_t vec_growth_page(size_t cap, size_t required, size_t size, size_t param)
+{
+    (void) cap;
+    if(!param) param = 4096;
+    size_t bytes = ((required * size + param - 1) / param) * param;
+    return bytes / size;
+}
+
+/*
+ * === THE REVERSAL KERNELS ===
+ * reverse n items of 1, 2, 4 or 8 bytes in place. blocks from both ends get
+ * reversed by a byte shuffle and swapped (32 bytes with AVX2, 16 with SSSE3,
+ * if compiled for it), the middle is swapped one item at a time
+ */
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+/* swap items of size bytes from both ends towards the middle */
+static inline void vec_reverse_scalar(unsigned char *lo, unsigned char *hi, size_t size)
+{
+    uint64_t a, b;
+    while((size_t)(hi - lo) >= 2 * size) {
+        hi -= size;
+        vec_memcpy(&a, lo, size);
+        vec_memcpy(&b, hi, size);
+        vec_memcpy(lo, &b, size);
+        vec_memcpy(hi, &a, size);
+        lo += size;
+    }
+}
+
+/* return boolean: true if reversed, false if there is no kernel for the size */
+static inline int vec_reverse_kernel(void *items, size_t n, size_t size)
+{
+    if(size != 1 && size != 2 && size != 4 && size != 8) return 0;
+    unsigned char *lo = items;
+    unsigned char *hi = lo + n * size;
+#if defined(__SSSE3__)
+    /* reverse the order of the items in a 16 byte lane, keeping their bytes */
+    unsigned char order[16];
+    for(size_t j = 0; j < 16; j++) {
+        order[j] = (unsigned char)((16 / size - 1 - j / size) * size + j % size);
+    }
+    __m128i mask = _mm_loadu_si128((const __m128i *)order);
+#if defined(__AVX2__)
+    __m256i mask2 = _mm256_broadcastsi128_si256(mask);
+    while(hi - lo >= 64) {
+        hi -= 32;
+        __m256i a = _mm256_loadu_si256((const __m256i *)lo);
+        __m256i b = _mm256_loadu_si256((const __m256i *)hi);
+        /* shuffle within the lanes, then swap the lanes */
+        a = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a, mask2), 0x4E);
+        b = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(b, mask2), 0x4E);
+        _mm256_storeu_si256((__m256i *)lo, b);
+        _mm256_storeu_si256((__m256i *)hi, a);
+        lo += 32;
+    }
+#endif
+    while(hi - lo >= 32) {
+        hi -= 16;
+        __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)lo), mask);
+        __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)hi), mask);
+        _mm_storeu_si128((__m128i *)lo, b);
+        _mm_storeu_si128((__m128i *)hi, a);
+        lo += 16;
+    }
+#endif
+    vec_reverse_scalar(lo, hi, size);
+    return 1;
+}
+
 #define VEC_IS_BY_REF_BY_REF 1
 #define VEC_IS_BY_REF_BY_VAL 0
 #define VEC_IS_BY_REF(M)     VEC_IS_BY_REF_##M
 
+#define VEC_STRUCT_SLABS_BY_REF VecSlab *slabs;
+#define VEC_STRUCT_SLABS_BY_VAL
+#define VEC_STRUCT_SLABS(M)     VEC_STRUCT_SLABS_##M
+
+#define VEC_STRUCT_INLINE_BY_REF(T)
+#define VEC_STRUCT_INLINE(T, M)         VEC_STRUCT_INLINE_##M(T)
+#define VEC_INLINE_ITEMS_BY_REF(vec)    0
+#define VEC_INLINE_ITEMS(vec, M)        VEC_INLINE_ITEMS_##M(vec)
+
 #define VEC_H
 #endif
 
@@ -119,6 +560,9 @@ typedef enum
         size_t last; \
         size_t first; \
         VEC_ITEM(T, M) *VEC_STRUCT_ITEMS; \
+        const VecAllocator *allocator; \
+        VEC_STRUCT_SLABS(M) \
+        VEC_STRUCT_INLINE(T, M) \
     } N; \
     \
     /* common implementation */ \
@@ -128,36 +572,47 @@ typedef enum
     int A##_empty(const N *vec); \
     int A##_resize(N *vec, size_t cap); \
     int A##_shrink(N *vec); \
+    int A##_shrink_to_fit(N *vec); \
     /* single item operations */ \
     int A##_push_front(N *vec, VEC_ITEM(T, M) val); \
     int A##_push_back(N *vec, VEC_ITEM(T, M) val); \
     int A##_push_at(N *vec, size_t index, VEC_ITEM(T, M) val); \
+    int A##_push_front_n(N *vec, const T *vals, size_t n); \
+    T *A##_emplace_front(N *vec); \
+    T *A##_emplace_back(N *vec); \
+    T *A##_emplace_at(N *vec, size_t index); \
+    int A##_push_back_n(N *vec, const T *vals, size_t n); \
+    int A##_push_at_n(N *vec, size_t index, const T *vals, size_t n); \
     /* TODO */ void A##_set_front(N *vec, VEC_ITEM(T, M) val); \
     /* TODO */ void A##_set_back(N *vec, VEC_ITEM(T, M) val); \
     void A##_set_at(N *vec, size_t index, VEC_ITEM(T, M) val); \
     void A##_pop_front(N *vec, T *val); \
     void A##_pop_back(N *vec, T *val); \
     void A##_pop_at(N *vec, size_t index, T *val); \
+    void A##_erase_range(N *vec, size_t from, size_t n); \
+    size_t A##_retain(N *vec, int (*pred)(const T *item, void *ctx), void *ctx); \
+    void A##_swap_remove(N *vec, size_t index, T *val); \
+    void A##_swap_remove_n(N *vec, const size_t *indices, size_t n); \
     VEC_ITEM(T, M) A##_get_front(const N *vec); \
     VEC_ITEM(T, M) A##_get_back(const N *vec); \
     VEC_ITEM(T, M) A##_get_at(const N *vec, size_t index); \
     /* slice operations */ \
-    /* TODO */ int A##_extend_front(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_extend_back(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_extend_at(N *vec, size_t index, N *v2, size_t n); \
-    /* TODO */ int A##_paste_front(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_paste_back(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_paste_at(N *vec, size_t index, N *v2, size_t n); \
-    /* TODO */ int A##_cut_front(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_cut_back(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_cut_at(N *vec, size_t from, size_t n, N *v2); \
-    /* TODO */ int A##_cat_front(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_cat_back(N *vec, N *v2, size_t n); \
-    /* TODO */ int A##_cat_at(N *vec, size_t from, size_t n, N *v2); \
+    int A##_extend_front(N *vec, N *v2, size_t n); \
+    int A##_extend_back(N *vec, N *v2, size_t n); \
+    int A##_extend_at(N *vec, size_t index, N *v2, size_t n); \
+    int A##_paste_front(N *vec, N *v2, size_t n); \
+    int A##_paste_back(N *vec, N *v2, size_t n); \
+    int A##_paste_at(N *vec, size_t index, N *v2, size_t n); \
+    int A##_cut_front(N *vec, N *v2, size_t n); \
+    int A##_cut_back(N *vec, N *v2, size_t n); \
+    int A##_cut_at(N *vec, size_t from, size_t n, N *v2); \
+    int A##_cat_front(N *vec, N *v2, size_t n); \
+    int A##_cat_back(N *vec, N *v2, size_t n); \
+    int A##_cat_at(N *vec, size_t from, size_t n, N *v2); \
     /* miscellaneous operations */ \
     void A##_swap(N *vec, size_t i1, size_t i2); \
     void A##_reverse(N *vec); \
-    /* TODO */ void A##_reverse_slice(N *vec, size_t from, size_t n); \
+    void A##_reverse_slice(N *vec, size_t from, size_t n); \
     VEC_ITEM(T, M)*A##_iter_begin(const N *vec); \
     VEC_ITEM(T, M)*A##_iter_end(const N *vec); \
     VEC_ITEM(T, M)*A##_iter_at(const N *vec, size_t index); \
@@ -167,6 +622,14 @@ typedef enum
     size_t A##_reserved(const N *vec); \
     int A##_reserve(N *vec, size_t cap); \
     int A##_copy(N *dst, const N *src); \
+    void A##_move(N *dst, N *src); \
+    void A##_swap_vectors(N *a, N *b); \
+    T *A##_detach(N *vec, size_t *len); \
+    int A##_adopt(N *vec, T *items, size_t len, size_t cap); \
+    /* statistics */ \
+    const VecStats *A##_stats(void); \
+    void A##_stats_reset(void); \
+    void A##_stats_dump(FILE *file); \
 
 /*
  * int A##_cmp(N *a, N *b) -> compare vec
@@ -183,8 +646,31 @@ typedef enum
     /*VEC_IMPLEMENT_COMMON_STATIC_F(N, A, T, F);              */\
     VEC_IMPLEMENT_COMMON_STATIC_ZERO(N, A, T, F);           \
     VEC_IMPLEMENT_COMMON_STATIC_GET(N, A, T, F, M);         \
-    VEC_IMPLEMENT_##M##_STATIC_SHRINK_BACK(N, A, T, F);     \
+    VEC_IMPLEMENT_COMMON_STATIC_STATS(N, A, T, F);          \
+    VEC_IMPLEMENT_COMMON_STATIC_MEMCPY(N, A, T, F);         \
+    VEC_IMPLEMENT_COMMON_STATIC_MEMMOVE(N, A, T, F);        \
+    VEC_IMPLEMENT_COMMON_STATIC_ALLOCATOR(N, A, T, F);      \
+    VEC_IMPLEMENT_COMMON_STATIC_PAD(N, A, T, F);            \
+    VEC_IMPLEMENT_COMMON_STATIC_MAPPED(N, A, T, F);         \
+    VEC_IMPLEMENT_COMMON_STATIC_INLINE(N, A, T, F, M);      \
+    VEC_IMPLEMENT_COMMON_STATIC_MALLOC(N, A, T, F);         \
+    VEC_IMPLEMENT_COMMON_STATIC_CALLOC(N, A, T, F);         \
+    VEC_IMPLEMENT_COMMON_STATIC_REALLOC(N, A, T, F);        \
+    VEC_IMPLEMENT_COMMON_STATIC_FREE(N, A, T, F);           \
+    VEC_IMPLEMENT_COMMON_STATIC_GROWTH(N, A, T, F, M);      \
+    VEC_IMPLEMENT_COMMON_STATIC_ZERO_END(N, A, T, F, M);    \
+    VEC_IMPLEMENT_##M##_STATIC_SHRINK_TO(N, A, T, F);       \
+    VEC_IMPLEMENT_COMMON_STATIC_SHRINK_BACK(N, A, T, F);    \
     VEC_IMPLEMENT_##M##_STATIC_SHRINK_FRONT(N, A, T, F);    \
+    VEC_IMPLEMENT_##M##_STATIC_HEADROOM(N, A, T, F);        \
+    VEC_IMPLEMENT_COMMON_STATIC_COMPACT(N, A, T, F);        \
+    VEC_IMPLEMENT_COMMON_STATIC_PLAIN(N, A, T, F);          \
+    VEC_IMPLEMENT_COMMON_STATIC_RELINK(N, A, T, F, M);      \
+    VEC_IMPLEMENT_COMMON_STATIC_OPEN(N, A, T, F, M);        \
+    VEC_IMPLEMENT_COMMON_STATIC_FILL(N, A, T, F, M);        \
+    VEC_IMPLEMENT_COMMON_STATIC_FILL_RAW(N, A, T, F, M);    \
+    VEC_IMPLEMENT_COMMON_STATIC_CLOSE(N, A, T, F, M);       \
+    VEC_IMPLEMENT_COMMON_STATIC_SLIDE(N, A, T, F, M);       \
     /* public */ \
     VEC_IMPLEMENT_COMMON_CLEAR(N, A, T, F);             \
     VEC_IMPLEMENT_COMMON_LENGTH(N, A, T, F);            \
@@ -192,19 +678,30 @@ typedef enum
     VEC_IMPLEMENT_COMMON_EMPTY(N, A, T, F);             \
     VEC_IMPLEMENT_COMMON_RESIZE(N, A, T, F);            \
     VEC_IMPLEMENT_COMMON_SHRINK(N, A, T, F);            \
+    VEC_IMPLEMENT_COMMON_SHRINK_TO_FIT(N, A, T, F);     \
     VEC_IMPLEMENT_COMMON_ITER_BEGIN(N, A, T, F, M);     \
     VEC_IMPLEMENT_COMMON_ITER_END(N, A, T, F, M);       \
     VEC_IMPLEMENT_COMMON_ITER_AT(N, A, T, F, M);        \
     VEC_IMPLEMENT_COMMON_POP_FRONT(N, A, T, F, M);      \
     VEC_IMPLEMENT_COMMON_POP_BACK(N, A, T, F, M);       \
     VEC_IMPLEMENT_COMMON_POP_AT(N, A, T, F, M);         \
+    VEC_IMPLEMENT_COMMON_ERASE_RANGE(N, A, T, F, M);    \
+    VEC_IMPLEMENT_COMMON_RETAIN(N, A, T, F, M);         \
+    VEC_IMPLEMENT_COMMON_SWAP_REMOVE(N, A, T, F, M);    \
+    VEC_IMPLEMENT_COMMON_SWAP_REMOVE_N(N, A, T, F, M);  \
     VEC_IMPLEMENT_COMMON_GET_AT(N, A, T, F, M);         \
     VEC_IMPLEMENT_COMMON_GET_FRONT(N, A, T, F, M);      \
     VEC_IMPLEMENT_COMMON_GET_BACK(N, A, T, F, M);       \
     VEC_IMPLEMENT_COMMON_SET_AT(N, A, T, F, M);         \
+    VEC_IMPLEMENT_COMMON_EMPLACE_FRONT(N, A, T, F, M);  \
+    VEC_IMPLEMENT_COMMON_EMPLACE_BACK(N, A, T, F, M);   \
+    VEC_IMPLEMENT_COMMON_EMPLACE_AT(N, A, T, F, M);     \
     VEC_IMPLEMENT_COMMON_PUSH_FRONT(N, A, T, F, M);     \
     VEC_IMPLEMENT_COMMON_PUSH_BACK(N, A, T, F, M);      \
     VEC_IMPLEMENT_COMMON_PUSH_AT(N, A, T, F, M);        \
+    VEC_IMPLEMENT_COMMON_PUSH_FRONT_N(N, A, T, F, M);   \
+    VEC_IMPLEMENT_COMMON_PUSH_BACK_N(N, A, T, F, M);    \
+    VEC_IMPLEMENT_COMMON_PUSH_AT_N(N, A, T, F, M);      \
     /* slice */ \
     VEC_IMPLEMENT_COMMON_EXTEND_FRONT(N, A, T, F, M);   \
     VEC_IMPLEMENT_COMMON_EXTEND_BACK(N, A, T, F, M);    \
@@ -220,12 +717,21 @@ typedef enum
     VEC_IMPLEMENT_COMMON_CAT_AT(N, A, T, F, M);         \
     /* rest */ \
     VEC_IMPLEMENT_COMMON_SWAP(N, A, T, F, M);           \
+    VEC_IMPLEMENT_COMMON_REVERSE_SLICE(N, A, T, F, M);  \
     VEC_IMPLEMENT_COMMON_REVERSE(N, A, T, F);           \
     VEC_IMPLEMENT_##M##_FREE(N, A, T, F);               \
     VEC_IMPLEMENT_##M##_ZERO(N, A, T, F);               \
     VEC_IMPLEMENT_##M##_RESERVED(N, A, T, F);           \
     VEC_IMPLEMENT_##M##_RESERVE(N, A, T, F);            \
     VEC_IMPLEMENT_##M##_COPY(N, A, T, F);               \
+    VEC_IMPLEMENT_COMMON_MOVE(N, A, T, F);              \
+    VEC_IMPLEMENT_COMMON_SWAP_VECTORS(N, A, T, F);      \
+    VEC_IMPLEMENT_##M##_DETACH(N, A, T, F);             \
+    VEC_IMPLEMENT_##M##_ADOPT(N, A, T, F);              \
+    /* statistics */ \
+    VEC_IMPLEMENT_COMMON_STATS(N, A, T, F);             \
+    VEC_IMPLEMENT_COMMON_STATS_RESET(N, A, T, F);       \
+    VEC_IMPLEMENT_COMMON_STATS_DUMP(N, A, T, F);        \
 
 /**********************************************************/
 /* PRIVATE FUNCTION IMPLEMENTATIONS ***********************/
@@ -259,28 +765,267 @@ typedef enum
     }
 
 /**
- * @brief A##_static_shrink_back [BY_VAL] - internal use, shrink end of vector (resize)
+ * @brief A##_static_stats [COMMON] - internal use, counters of this instantiation (see VEC_SETTINGS_STATS)
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_STATS(N, A, T, F) \
+    static VecStats A##_static_stats
+
+/**
+ * @brief A##_static_memcpy [COMMON] - internal use, copy items between allocations
+ * @param dst - destination
+ * @param src - source
+ * @param size - number of bytes
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_MEMCPY(N, A, T, F) \
+    static inline void A##_static_memcpy(void *dst, const void *src, size_t size) \
+    { \
+        VEC_STATS_ADD(A, bytes_copied, size); \
+        vec_memcpy(dst, src, size); \
+    }
+
+/**
+ * @brief A##_static_memmove [COMMON] - internal use, shift items within an allocation
+ * @param dst - destination
+ * @param src - source
+ * @param size - number of bytes
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_MEMMOVE(N, A, T, F) \
+    static inline void A##_static_memmove(void *dst, const void *src, size_t size) \
+    { \
+        VEC_STATS_ADD(A, memmoves, 1); \
+        VEC_STATS_ADD(A, bytes_moved, size); \
+        vec_memmove(dst, src, size); \
+    }
+
+/**
+ * @brief A##_static_allocator [COMMON] - internal use, get the allocator in charge of a vector
+ * @param vec - the vector
+ * @return the allocator attached to the vector, else the one of the instantiation (may be 0)
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_ALLOCATOR(N, A, T, F) \
+    static inline const VecAllocator *A##_static_allocator(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return vec->allocator ? vec->allocator : VEC_ALLOCATOR; \
+    }
+
+/**
+ * @brief A##_static_pad [COMMON] - internal use, pad a size to a multiple of VEC_ALIGN
+ * @param size - number of bytes
+ * @return padded number of bytes
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_PAD(N, A, T, F) \
+    static inline size_t A##_static_pad(size_t size) \
+    { \
+        size_t align = VEC_ALIGN; \
+        if(!align) return size; \
+        return ((size + align - 1) / align) * align; \
+    }
+
+/**
+ * @brief A##_static_mapped [COMMON] - internal use, check if memory of a certain size is backed by a mapping
+ * @param vec - the vector
+ * @param size - number of bytes
+ * @return VEC_MAPPED_HUGE, VEC_MAPPED_PAGES or VEC_MAPPED_NONE if allocated
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_MAPPED(N, A, T, F) \
+    static inline VecMapped A##_static_mapped(const N *vec, size_t size) \
+    { \
+        size_t threshold = VEC_MREMAP_THRESHOLD; \
+        size_t threshold_huge = VEC_HUGEPAGE_THRESHOLD; \
+        if(!VEC_MMAP_AVAILABLE || A##_static_allocator(vec)) return VEC_MAPPED_NONE; \
+        size = A##_static_pad(size); \
+        if(threshold_huge && size >= threshold_huge) return VEC_MAPPED_HUGE; \
+        if(threshold && size >= threshold) return VEC_MAPPED_PAGES; \
+        return VEC_MAPPED_NONE; \
+    }
+
+/**
+ * @brief A##_static_inline [COMMON] - internal use, check if the items are stored within the vector struct
+ * @param vec - the vector
+ * @return boolean: true if inline, false if allocated (or nothing yet)
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_INLINE(N, A, T, F, M) \
+    static inline int A##_static_inline(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        size_t inline_cap = VEC_IS_BY_REF(M) ? 0 : VEC_INLINE_CAP; \
+        return inline_cap && vec->cap == inline_cap; \
+    }
+
+/**
+ * @brief A##_static_malloc [COMMON] - internal use, allocate memory for a vector
+ * @param vec - the vector
+ * @param size - number of bytes
+ * @return pointer to memory or 0 if failure
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_MALLOC(N, A, T, F) \
+    static inline void *A##_static_malloc(const N *vec, size_t size) \
+    { \
+        const VecAllocator *allocator = A##_static_allocator(vec); \
+        size = A##_static_pad(size); \
+        VEC_STATS_ADD(A, allocs, 1); \
+        if(allocator) { \
+            void *ptr = allocator->alloc(allocator->user, size); \
+            size_t align = VEC_ALIGN; \
+            VEC_ASSERT_REAL(!align || !((uintptr_t)ptr % align)); \
+            (void) align; \
+            return ptr; \
+        } \
+        VecMapped mapped = A##_static_mapped(vec, size); \
+        if(mapped) return vec_mapped_alloc(mapped, size); \
+        return vec_heap_alloc(VEC_ALIGN, size); \
+    }
+
+/**
+ * @brief A##_static_calloc [COMMON] - internal use, allocate zeroed memory for a vector
+ * @param vec - the vector
+ * @param size - number of bytes
+ * @return pointer to memory or 0 if failure
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_CALLOC(N, A, T, F) \
+    static inline void *A##_static_calloc(const N *vec, size_t size) \
+    { \
+        const VecAllocator *allocator = A##_static_allocator(vec); \
+        if(allocator || VEC_ALIGN) { \
+            void *ptr = A##_static_malloc(vec, size); \
+            if(ptr && !A##_static_mapped(vec, size)) vec_memset(ptr, 0, size); \
+            return ptr; \
+        } \
+        VEC_STATS_ADD(A, allocs, 1); \
+        VecMapped mapped = A##_static_mapped(vec, size); \
+        if(mapped) return vec_mapped_alloc(mapped, size); \
+        return vec_calloc(1, size); \
+    }
+
+/**
+ * @brief A##_static_realloc [COMMON] - internal use, reallocate memory of a vector
+ * @param vec - the vector
+ * @param ptr - the memory to be reallocated
+ * @param size_old - current number of bytes
+ * @param size_new - desired number of bytes
+ * @return pointer to memory or 0 if failure
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_REALLOC(N, A, T, F) \
+    static inline void *A##_static_realloc(const N *vec, void *ptr, size_t size_old, size_t size_new) \
+    { \
+        const VecAllocator *allocator = A##_static_allocator(vec); \
+        size_old = A##_static_pad(size_old); \
+        size_new = A##_static_pad(size_new); \
+        size_t size_kept = size_old < size_new ? size_old : size_new; \
+        VEC_STATS_ADD(A, reallocs, ptr != 0); \
+        VEC_STATS_ADD(A, allocs, ptr == 0); \
+        if(allocator) { \
+            void *result = allocator->realloc(allocator->user, ptr, size_old, size_new); \
+            if(ptr && result && result != ptr) VEC_STATS_ADD(A, bytes_copied, size_kept); \
+            size_t align = VEC_ALIGN; \
+            VEC_ASSERT_REAL(!align || !((uintptr_t)result % align)); \
+            (void) align; \
+            return result; \
+        } \
+        VecMapped mapped_old = ptr ? A##_static_mapped(vec, size_old) : VEC_MAPPED_NONE; \
+        VecMapped mapped_new = A##_static_mapped(vec, size_new); \
+        if(mapped_old && mapped_old == mapped_new) return vec_mapped_realloc(mapped_new, ptr, size_old, size_new); \
+        if(ptr && size_old == size_new) return ptr; \
+        if(mapped_old || mapped_new || VEC_ALIGN) { \
+            /* crossing a threshold, move between allocation and mappings */ \
+            /* (there is no aligned realloc either, so always move aligned memory) */ \
+            void *result = mapped_new ? vec_mapped_alloc(mapped_new, size_new) : vec_heap_alloc(VEC_ALIGN, size_new); \
+            if(!result) return 0; \
+            if(ptr) A##_static_memcpy(result, ptr, size_kept); \
+            if(mapped_old) vec_mapped_free(mapped_old, ptr, size_old); \
+            else vec_free(ptr); \
+            return result; \
+        } \
+        void *result = vec_realloc(ptr, size_new); \
+        if(ptr && result && result != ptr) VEC_STATS_ADD(A, bytes_copied, size_kept); \
+        return result; \
+    }
+
+/**
+ * @brief A##_static_free [COMMON] - internal use, free memory of a vector
+ * @param vec - the vector
+ * @param ptr - the memory to be freed
+ * @param size - number of bytes
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_FREE(N, A, T, F) \
+    static inline void A##_static_free(const N *vec, void *ptr, size_t size) \
+    { \
+        const VecAllocator *allocator = A##_static_allocator(vec); \
+        size = A##_static_pad(size); \
+        if(ptr) VEC_STATS_ADD(A, frees, 1); \
+        if(allocator) { \
+            if(ptr) allocator->free(allocator->user, ptr, size); \
+            return; \
+        } \
+        VecMapped mapped = A##_static_mapped(vec, size); \
+        if(mapped) vec_mapped_free(mapped, ptr, size); \
+        else vec_free(ptr); \
+    }
+
+/**
+ * @brief A##_static_growth [COMMON] - internal use, apply the growth policy
+ * @param cap - current capacity in items, zero if none
+ * @param required - the minimum capacity in items
+ * @return capacity in items to use
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_GROWTH(N, A, T, F, M) \
+    static inline size_t A##_static_growth(size_t cap, size_t required) \
+    { \
+        if(!cap) cap = VEC_DEFAULT_SIZE; \
+        if(cap >= required) return cap; \
+        return VEC_GROWTH(cap, required, sizeof(VEC_ITEM(T, M)), VEC_GROWTH_PARAM); \
+    }
+
+/**
+ * @brief A##_static_zero_end [COMMON] - internal use, zero the VEC_KEEP_ZERO_END items after the last one, if reserved memory isn't zeroed anyways
  * @param vec - the vector
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_ZERO_END(N, A, T, F, M) \
+    static inline void A##_static_zero_end(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        if(!VEC_KEEP_ZERO_END || VEC_IS_BY_REF(M) || VEC_ZERO_INIT || F != 0) return; \
+        if(vec->last + VEC_KEEP_ZERO_END > vec->cap) return; \
+        vec_memset(&vec->VEC_STRUCT_ITEMS[vec->last], 0, sizeof(*vec->VEC_STRUCT_ITEMS) * VEC_KEEP_ZERO_END); \
+    }
+
+/**
+ * @brief A##_static_shrink_to [BY_VAL] - internal use, shrink end of vector to a capacity
+ * @param vec - the vector
+ * @param required - capacity in items, at least vec->last (zero frees the vector)
  * @return zero if success, non-zero if failure
  */
-#define VEC_IMPLEMENT_BY_VAL_STATIC_SHRINK_BACK(N, A, T, F) \
-    static inline int A##_static_shrink_back(N *vec) \
+#define VEC_IMPLEMENT_BY_VAL_STATIC_SHRINK_TO(N, A, T, F) \
+    static inline int A##_static_shrink_to(N *vec, size_t required) \
     { \
         VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(!required || required >= vec->last); \
         size_t cap = vec->cap; \
-        size_t last = vec->last; \
-        size_t required = vec->cap ? vec->cap : VEC_DEFAULT_SIZE;\
-        while(required > last) required /= 2; \
-        required *= 2; \
+        size_t inline_cap = VEC_INLINE_CAP; \
+        if(required && required < inline_cap) required = inline_cap; \
         if(required  < vec->cap) { \
+            VEC_STATS_ADD(A, shrinks, 1); \
             if(required) { \
                 if(F != 0) { \
                     for(size_t i = required; i < cap; i++) { \
                         VEC_TYPE_FREE(F, &vec->VEC_STRUCT_ITEMS[i], T); \
                     } \
                 } \
-                void *temp = vec_realloc(vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
-                if(!temp) return VEC_ERROR_REALLOC; \
+                void *temp = 0; \
+                if(required == inline_cap) { \
+                    /* move back into the inline storage */ \
+                    temp = VEC_INLINE_ITEMS(vec, BY_VAL); \
+                    A##_static_memcpy(temp, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
+                    A##_static_free(vec, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * cap); \
+                } else { \
+                    temp = A##_static_realloc(vec, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * cap, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
+                    if(!temp) return VEC_ERROR_REALLOC; \
+                } \
                 vec->VEC_STRUCT_ITEMS = temp; \
                 vec->cap = required; \
             } else { \
@@ -290,6 +1035,22 @@ typedef enum
         return VEC_ERROR_NONE; \
     }
 
+/**
+ * @brief A##_static_shrink_back [COMMON] - internal use, shrink end of vector (resize), once it dropped below the low-water mark
+ * @param vec - the vector
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_SHRINK_BACK(N, A, T, F) \
+    static inline int A##_static_shrink_back(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        size_t last = vec->last; \
+        size_t low = VEC_SHRINK_LOW; \
+        if(!last) return A##_static_shrink_to(vec, 0); \
+        if(low && last + VEC_KEEP_ZERO_END >= vec->cap / low) return VEC_ERROR_NONE; \
+        return A##_static_shrink_to(vec, A##_static_growth(0, last + VEC_KEEP_ZERO_END)); \
+    }
+
 /**
  * @brief A##_static_shrink_front [BY_VAL] - internal use, shrink vector at beginning (resize)
  * @param vec - the vector
@@ -308,43 +1069,275 @@ typedef enum
                     VEC_TYPE_FREE(F, &vec->VEC_STRUCT_ITEMS[i], T); \
                 } \
             } \
-            vec_memmove(item, item + first, sizeof(T) * (vec->last - first)); \
+            A##_static_memmove(item, item + first, sizeof(T) * (vec->last - first)); \
             /* TODO: is that really needed? */ vec_memset(item + vec->last - first, 0, sizeof(T) * (first)); \
             vec->last -= first; \
         } \
         return 0; \
     }
 
+/**
+ * @brief A##_static_compact [COMMON] - internal use, drop a dead prefix (left by popping the front) instead of growing, see VEC_SETTINGS_COMPACT_FRONT
+ * @param vec - the vector
+ * @param cap - the desired item capacity, reduced by the number of items dropped
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_COMPACT(N, A, T, F) \
+    static inline int A##_static_compact(N *vec, size_t *cap) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(cap); \
+        size_t divisor = VEC_COMPACT_FRONT; \
+        size_t first = vec->first; \
+        if(!divisor || !first) return VEC_ERROR_NONE; \
+        /* only worth it if we'd reallocate otherwise */ \
+        if(*cap + VEC_KEEP_ZERO_END <= vec->cap) return VEC_ERROR_NONE; \
+        if(first < vec->cap / divisor) return VEC_ERROR_NONE; \
+        int result = A##_static_shrink_front(vec); \
+        if(result) return result; \
+        *cap = *cap > first ? *cap - first : 0; \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_static_open [COMMON] - internal use, make room for n items at index by moving the items behind it back (and adjust length)
+ * @param vec - the vector
+ * @param index - the index, up to the length
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_OPEN(N, A, T, F, M) \
+    static inline int A##_static_open(N *vec, size_t index, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(index <= A##_length(vec)); \
+        if(!n) return VEC_ERROR_NONE; \
+        int result = A##_reserve(vec, vec->last + n); \
+        if(result) return result; \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first + index]; \
+        size_t tail = vec->last - vec->first - index; \
+        if((VEC_IS_BY_REF(M) || F != 0) && n == 1) { \
+            /* rotate the spare slot into the room, since it's alloced (or popped but not freed) */ \
+            VEC_ITEM(T, M) residual = item[tail]; \
+            A##_static_memmove(item + 1, item, sizeof(*item) * tail); \
+            item[0] = residual; \
+        } else if(VEC_IS_BY_REF(M) || F != 0) { \
+            /* rotate the spare slots into the room, since they're alloced (or popped but not freed) */ \
+            VEC_ITEM(T, M) *residuals = A##_static_malloc(vec, sizeof(*item) * n); \
+            if(!residuals) return VEC_ERROR_MALLOC; \
+            A##_static_memcpy(residuals, item + tail, sizeof(*item) * n); \
+            A##_static_memmove(item + n, item, sizeof(*item) * tail); \
+            A##_static_memcpy(item, residuals, sizeof(*item) * n); \
+            A##_static_free(vec, residuals, sizeof(*item) * n); \
+        } else if(tail) { \
+            A##_static_memmove(item + n, item, sizeof(*item) * tail); \
+        } \
+        vec->last += n; \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_static_fill [COMMON] - internal use, overwrite n items starting at index with copies of other items, freeing the previous ones
+ * @param vec - the vector
+ * @param index - the index
+ * @param items - the items to copy, not in the overwritten range
+ * @param n - number of items, index + n up to the length
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_FILL(N, A, T, F, M) \
+    static inline void A##_static_fill(N *vec, size_t index, VEC_ITEM(T, M) *items, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(index + n <= A##_length(vec)); \
+        if(!n) return; \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first + index]; \
+        if(VEC_IS_BY_REF(M) || F != 0) { \
+            for(size_t i = 0; i < n; i++) { \
+                T *dst = VEC_REF(M) item[i]; \
+                if(F != 0) VEC_TYPE_FREE(F, dst, T); \
+                vec_memcpy(dst, VEC_REF(M) items[i], sizeof(T)); \
+            } \
+        } else { \
+            A##_static_memcpy(item, items, sizeof(*item) * n); \
+        } \
+    }
+
+/**
+ * @brief A##_static_fill_raw [COMMON] - internal use, overwrite n items starting at index with copies of a plain array, freeing the previous ones
+ * @param vec - the vector
+ * @param index - the index
+ * @param vals - the items to copy (by value, also for BY_REF)
+ * @param n - number of items, index + n up to the length
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_FILL_RAW(N, A, T, F, M) \
+    static inline void A##_static_fill_raw(N *vec, size_t index, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(index + n <= A##_length(vec)); \
+        if(!n) return; \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first + index]; \
+        if(VEC_IS_BY_REF(M) || F != 0) { \
+            for(size_t i = 0; i < n; i++) { \
+                T *dst = VEC_REF(M) item[i]; \
+                if(F != 0) VEC_TYPE_FREE(F, dst, T); \
+                vec_memcpy(dst, &vals[i], sizeof(T)); \
+            } \
+        } else { \
+            A##_static_memcpy(item, vals, sizeof(T) * n); \
+        } \
+    }
+
+/**
+ * @brief A##_static_close [COMMON] - internal use, remove n items at index whose content got moved elsewhere (and adjust length)
+ * @param vec - the vector
+ * @param index - the index
+ * @param n - number of items, index + n up to the length
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_CLOSE(N, A, T, F, M) \
+    static inline int A##_static_close(N *vec, size_t index, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(index + n <= A##_length(vec)); \
+        if(!n) return VEC_ERROR_NONE; \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first + index]; \
+        size_t tail = vec->last - vec->first - index - n; \
+        if(F != 0) { \
+            /* the content is owned elsewhere now, don't free it through these slots */ \
+            for(size_t i = 0; i < n; i++) { \
+                vec_memset(VEC_REF(M) item[i], 0, sizeof(T)); \
+            } \
+        } \
+        if(!index) { \
+            /* the slots stay in front, like popping the front */ \
+            vec->first += n; \
+            if(vec->first == vec->last) A##_clear(vec); \
+            return VEC_ERROR_NONE; \
+        } \
+        if(tail) { \
+            if(VEC_IS_BY_REF(M) || F != 0) { \
+                /* rotate the slots behind the last item, since they're alloced (or zeroed) */ \
+                VEC_ITEM(T, M) *residuals = A##_static_malloc(vec, sizeof(*item) * n); \
+                if(!residuals) return VEC_ERROR_MALLOC; \
+                A##_static_memcpy(residuals, item, sizeof(*item) * n); \
+                A##_static_memmove(item, item + n, sizeof(*item) * tail); \
+                A##_static_memcpy(item + tail, residuals, sizeof(*item) * n); \
+                A##_static_free(vec, residuals, sizeof(*item) * n); \
+            } else { \
+                A##_static_memmove(item, item + n, sizeof(*item) * tail); \
+            } \
+        } \
+        vec->last -= n; \
+        A##_static_zero_end(vec); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_static_slide [COMMON] - internal use, move the item of one slot into a vacated (freed and zeroed, if there is a free function) slot, leaving the source vacated
+ * @param dst - the vacated slot
+ * @param src - the slot of the item
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_SLIDE(N, A, T, F, M) \
+    static inline void A##_static_slide(VEC_ITEM(T, M) *dst, VEC_ITEM(T, M) *src) \
+    { \
+        if(VEC_IS_BY_REF(M)) { \
+            /* swap the bodies, so the vacated one stays alloced */ \
+            VEC_ITEM(T, M) tmp; \
+            vec_memcpy(&tmp, dst, sizeof(tmp)); \
+            vec_memcpy(dst, src, sizeof(tmp)); \
+            vec_memcpy(src, &tmp, sizeof(tmp)); \
+        } else { \
+            vec_memcpy(dst, src, sizeof(*dst)); \
+            if(F != 0) vec_memset(src, 0, sizeof(*src)); \
+        } \
+    }
+
+/**
+ * @brief A##_static_plain [COMMON] - internal use, check if memory of a certain size is plain vec_malloc memory (no allocator, mapping or alignment), so it can be handed over
+ * @param vec - the vector
+ * @param size - number of bytes
+ * @return boolean: true if plain, false if not
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_PLAIN(N, A, T, F) \
+    static inline int A##_static_plain(const N *vec, size_t size) \
+    { \
+        return !A##_static_allocator(vec) && !A##_static_mapped(vec, size) && !VEC_ALIGN; \
+    }
+
+/**
+ * @brief A##_static_relink [COMMON] - internal use, point the items back to the inline storage after the struct got copied
+ * @param vec - the vector
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATIC_RELINK(N, A, T, F, M) \
+    static inline void A##_static_relink(N *vec) \
+    { \
+        if(A##_static_inline(vec)) vec->VEC_STRUCT_ITEMS = VEC_INLINE_ITEMS(vec, M); \
+    }
+
+/**
+ * @brief A##_static_headroom [BY_VAL] - internal use, make room in front of the first item (push front)
+ * @param vec - the vector, without any room in front (first is zero)
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_BY_VAL_STATIC_HEADROOM(N, A, T, F) \
+    static inline int A##_static_headroom(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(!vec->first); \
+        size_t len = vec->last; \
+        /* room proportional to the length, so repeated pushes to the front are amortized O(1) */ \
+        size_t gap = len / 2 + 1; \
+        int result = A##_reserve(vec, len + gap); \
+        if(result) return result; \
+        T *item = vec->VEC_STRUCT_ITEMS; \
+        if(F != 0) { \
+            /* free what's overwritten and don't leave copies of live items behind */ \
+            for(size_t i = len; i < len + gap; i++) { \
+                VEC_TYPE_FREE(F, &item[i], T); \
+            } \
+        } \
+        A##_static_memmove(item + gap, item, sizeof(T) * len); \
+        if(F != 0) vec_memset(item, 0, sizeof(T) * gap); \
+        vec->first = gap; \
+        vec->last = len + gap; \
+        return VEC_ERROR_NONE; \
+    }
+
 /* implementation by ref */
 
 /**
- * @brief A##_static_shrink_back [BY_REF] - internal use, shrink end of vector (resize)
+ * @brief A##_static_shrink_to [BY_REF] - internal use, shrink end of vector to a capacity
  * @param vec - the vector
+ * @param required - capacity in items, at least vec->last (zero frees the vector)
  * @return zero if success, non-zero if failure
  */
-#define VEC_IMPLEMENT_BY_REF_STATIC_SHRINK_BACK(N, A, T, F) \
-    static inline int A##_static_shrink_back(N *vec) \
+#define VEC_IMPLEMENT_BY_REF_STATIC_SHRINK_TO(N, A, T, F) \
+    static inline int A##_static_shrink_to(N *vec, size_t required) \
     { \
         VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(!required || required >= vec->last); \
         size_t cap = vec->cap; \
-        size_t last = vec->last; \
-        size_t required = vec->cap ? vec->cap : VEC_DEFAULT_SIZE;\
-        while(required > last) required /= 2; \
-        required *= 2; \
         if(required < vec->cap) { \
             if(required) { \
+                /* slab bodies share their slab with live items, only A##_free releases them */ \
+                if(VEC_SLAB) return VEC_ERROR_NONE; \
+                VEC_STATS_ADD(A, shrinks, 1); \
                 for(size_t i = required; i < cap; i++) { \
                     if(F != 0) { \
                         VEC_TYPE_FREE(F, vec->VEC_STRUCT_ITEMS[i], T); \
                     } \
-                    free(vec->VEC_STRUCT_ITEMS[i]); \
+                    A##_static_free(vec, vec->VEC_STRUCT_ITEMS[i], sizeof(**vec->VEC_STRUCT_ITEMS)); \
                     /*memset(&vec->VEC_STRUCT_ITEMS[i], 0, sizeof(vec->VEC_STRUCT_ITEMS[i]));*/ \
                 } \
-                void *temp = vec_realloc(vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
+                void *temp = A##_static_realloc(vec, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * cap, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
                 if(!temp) return VEC_ERROR_REALLOC; \
                 vec->VEC_STRUCT_ITEMS = temp; \
                 vec->cap = required; \
             } else { \
+                VEC_STATS_ADD(A, shrinks, 1); \
                 A##_free(vec); \
             } \
         } \
@@ -367,20 +1360,49 @@ typedef enum
             if(F != 0) { \
                 for(size_t i = 0; i < first; i++) { \
                     VEC_TYPE_FREE(F, vec->VEC_STRUCT_ITEMS[i], T); \
+                    vec_memset(vec->VEC_STRUCT_ITEMS[i], 0, sizeof(T)); \
                 } \
             } \
             /* we have to preserve all items, since they're alloced */ \
-            T **residuals = malloc(sizeof(T *) * first); \
+            T **residuals = A##_static_malloc(vec, sizeof(T *) * first); \
             if(!residuals) return VEC_ERROR_MALLOC; \
-            vec_memcpy(residuals, item, sizeof(T *) * (first)); \
-            vec_memmove(item, item + first, sizeof(T *) * (vec->last - first)); \
-            vec_memcpy(item + vec->last - first, residuals, sizeof(T *) * (first)); \
-            free(residuals); \
+            A##_static_memcpy(residuals, item, sizeof(T *) * (first)); \
+            A##_static_memmove(item, item + first, sizeof(T *) * (vec->last - first)); \
+            A##_static_memcpy(item + vec->last - first, residuals, sizeof(T *) * (first)); \
+            A##_static_free(vec, residuals, sizeof(T *) * first); \
             vec->last -= first; \
         } \
         return 0; \
     }
 
+/**
+ * @brief A##_static_headroom [BY_REF] - internal use, make room in front of the first item (push front)
+ * @param vec - the vector, without any room in front (first is zero)
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_BY_REF_STATIC_HEADROOM(N, A, T, F) \
+    static inline int A##_static_headroom(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(!vec->first); \
+        size_t len = vec->last; \
+        /* room proportional to the length, so repeated pushes to the front are amortized O(1) */ \
+        size_t gap = len / 2 + 1; \
+        int result = A##_reserve(vec, len + gap); \
+        if(result) return result; \
+        /* rotate the spare bodies to the front, since they're alloced */ \
+        T **item = vec->VEC_STRUCT_ITEMS; \
+        T **residuals = A##_static_malloc(vec, sizeof(T *) * gap); \
+        if(!residuals) return VEC_ERROR_MALLOC; \
+        A##_static_memcpy(residuals, item + len, sizeof(T *) * gap); \
+        A##_static_memmove(item + gap, item, sizeof(T *) * len); \
+        A##_static_memcpy(item, residuals, sizeof(T *) * gap); \
+        A##_static_free(vec, residuals, sizeof(T *) * gap); \
+        vec->first = gap; \
+        vec->last = len + gap; \
+        return VEC_ERROR_NONE; \
+    }
+
 
 /**********************************************************/
 /* PUBLIC FUNCTION IMPLEMENTATIONS ************************/
@@ -481,6 +1503,52 @@ typedef enum
         return result; \
     }
 
+/**
+ * @brief A##_shrink_to_fit [COMMON] - shrink memory usage to exactly the number of items in use, regardless of the growth policy and low-water mark
+ * @param vec - the vector
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_SHRINK_TO_FIT(N, A, T, F) \
+    inline int A##_shrink_to_fit(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        int result = A##_static_shrink_front(vec); \
+        size_t last = vec->last; \
+        result |= result ?: A##_static_shrink_to(vec, last ? last + VEC_KEEP_ZERO_END : 0); \
+        return result; \
+    }
+
+/**
+ * @brief A##_stats [COMMON] - get the counters of this instantiation (all zero unless VEC_SETTINGS_STATS is set)
+ * @return pointer to the counters
+ */
+#define VEC_IMPLEMENT_COMMON_STATS(N, A, T, F) \
+    inline const VecStats *A##_stats(void) \
+    { \
+        return &A##_static_stats; \
+    }
+
+/**
+ * @brief A##_stats_reset [COMMON] - reset the counters of this instantiation
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATS_RESET(N, A, T, F) \
+    inline void A##_stats_reset(void) \
+    { \
+        vec_memset(&A##_static_stats, 0, sizeof(A##_static_stats)); \
+    }
+
+/**
+ * @brief A##_stats_dump [COMMON] - print the counters of this instantiation
+ * @param file - where to print to (e.g. stderr)
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_STATS_DUMP(N, A, T, F) \
+    inline void A##_stats_dump(FILE *file) \
+    { \
+        vec_stats_print(file, #N, &A##_static_stats); \
+    }
+
 /**
  * @brief A##_iter_begin [COMMON] - get pointer to first item
  * @param vec - the vector
@@ -596,41 +1664,224 @@ typedef enum
     }
 
 /**
- * @brief A##_set_at [COMMON] - overwrite one item at certain index
+ * @brief A##_set_at [COMMON] - overwrite one item at certain index
+ * @param vec - the vector
+ * @param index - the certain index
+ * @param val - the value (by reference) to overwrite said index with
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_SET_AT(N, A, T, F, M) \
+    inline void A##_set_at(N *vec, size_t index, VEC_ITEM(T, M) val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT(val, M); \
+        T *item = VEC_REF(M) *A##_static_get(vec, index + vec->first); \
+        if(F != 0) VEC_TYPE_FREE(F, item, T); \
+        vec_memcpy(item, VEC_REF(M) val, sizeof(T)); \
+    }
+
+/**
+ * @brief A##_pop_at [COMMON] - pop one item from the back (and adjust length)
+ * @param vec - the vector
+ * @param index - the index
+ * @param val - write back for popped value, pass 0 to ignore
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_POP_AT(N, A, T, F, M) \
+    inline void A##_pop_at(N *vec, size_t index, T *val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT(val, M); \
+        VEC_ITEM(T, M) *item = A##_static_get(vec, index + vec->first); \
+        if(val) { \
+            vec_memcpy(val, VEC_REF(M) *item, sizeof(T)); \
+        } \
+        vec->last--; \
+        A##_static_memmove(item, item + 1, sizeof(*item) * (vec->last - index - vec->first)); \
+        return; \
+    }
+
+/**
+ * @brief A##_erase_range [COMMON] - remove n items starting at an index, freeing them, in one pass (and adjust length)
+ * @param vec - the vector
+ * @param from - the index
+ * @param n - number of items, from + n up to the length
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_ERASE_RANGE(N, A, T, F, M) \
+    inline void A##_erase_range(N *vec, size_t from, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(from + n <= A##_length(vec)); \
+        if(!n) return; \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first + from]; \
+        size_t tail = vec->last - vec->first - from - n; \
+        if(F != 0) { \
+            for(size_t i = 0; i < n; i++) { \
+                VEC_TYPE_FREE(F, VEC_REF(M) item[i], T); \
+                vec_memset(VEC_REF(M) item[i], 0, sizeof(T)); \
+            } \
+        } \
+        if(!from) { \
+            /* the slots stay in front, like popping the front */ \
+            vec->first += n; \
+            if(vec->first == vec->last) A##_clear(vec); \
+            A##_static_zero_end(vec); \
+            return; \
+        } \
+        if(VEC_IS_BY_REF(M) || F != 0) { \
+            /* the vacated slots move behind the last item */ \
+            for(size_t i = 0; i < tail; i++) { \
+                A##_static_slide(&item[i], &item[i + n]); \
+            } \
+        } else { \
+            A##_static_memmove(item, item + n, sizeof(*item) * tail); \
+        } \
+        vec->last -= n; \
+        A##_static_zero_end(vec); \
+    }
+
+/**
+ * @brief A##_retain [COMMON] - keep only the items a predicate holds for, freeing the others, in one stable pass (and adjust length)
+ * @param vec - the vector
+ * @param pred - the predicate, returns non-zero to keep an item
+ * @param ctx - passed on to the predicate
+ * @return number of items removed
+ */
+#define VEC_IMPLEMENT_COMMON_RETAIN(N, A, T, F, M) \
+    inline size_t A##_retain(N *vec, int (*pred)(const T *item, void *ctx), void *ctx) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(pred); \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first]; \
+        size_t len = A##_length(vec); \
+        size_t kept = 0; \
+        for(size_t i = 0; i < len; i++) { \
+            if(pred(VEC_REF(M) item[i], ctx)) { \
+                if(kept != i) A##_static_slide(&item[kept], &item[i]); \
+                kept++; \
+            } else if(F != 0) { \
+                VEC_TYPE_FREE(F, VEC_REF(M) item[i], T); \
+                vec_memset(VEC_REF(M) item[i], 0, sizeof(T)); \
+            } \
+        } \
+        vec->last = vec->first + kept; \
+        if(!kept) A##_clear(vec); \
+        A##_static_zero_end(vec); \
+        return len - kept; \
+    }
+
+/**
+ * @brief A##_swap_remove [COMMON] - pop one item at an index by moving the last item into its place, O(1) but not keeping the order (and adjust length)
+ * @param vec - the vector
+ * @param index - the index
+ * @param val - write back for popped value, pass 0 to ignore
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_SWAP_REMOVE(N, A, T, F, M) \
+    inline void A##_swap_remove(N *vec, size_t index, T *val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        size_t back = A##_length(vec) - 1; \
+        if(index != back) A##_swap(vec, index, back); \
+        /* the item ends up in the popped slot, like popping the back */ \
+        A##_pop_back(vec, val); \
+    }
+
+/**
+ * @brief A##_swap_remove_n [COMMON] - remove the items at a list of indices, freeing them, by moving items from the back into their places, in one pass not keeping the order (and adjust length)
+ * @param vec - the vector
+ * @param indices - the indices, sorted ascending and unique
+ * @param n - number of indices
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_SWAP_REMOVE_N(N, A, T, F, M) \
+    inline void A##_swap_remove_n(N *vec, const size_t *indices, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(indices || !n); \
+        VEC_ASSERT_REAL(n <= A##_length(vec)); \
+        if(!n) return; \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first]; \
+        /* going from the highest index down, the back is never an item still to be removed */ \
+        for(size_t k = n; k > 0; k--) { \
+            size_t index = indices[k - 1]; \
+            size_t back = vec->last - vec->first - 1; \
+            VEC_ASSERT_REAL(index <= back); \
+            VEC_ASSERT_REAL(k < 2 || indices[k - 2] < index); \
+            if(F != 0) { \
+                VEC_TYPE_FREE(F, VEC_REF(M) item[index], T); \
+                vec_memset(VEC_REF(M) item[index], 0, sizeof(T)); \
+            } \
+            if(index != back) A##_static_slide(&item[index], &item[back]); \
+            vec->last--; \
+        } \
+        if(vec->first == vec->last) A##_clear(vec); \
+        A##_static_zero_end(vec); \
+    }
+
+/**
+ * @brief A##_emplace_front [COMMON] - add one slot to the front, into the room left in front of the first item (made if there is none, except with VEC_KEEP_ZERO_END, see A##_push_front)
+ * @param vec - the vector
+ * @return pointer to the new item (the body, for BY_REF) to construct in place, zeroed if there is a free function; 0 if failure
+ */
+#define VEC_IMPLEMENT_COMMON_EMPLACE_FRONT(N, A, T, F, M) \
+    inline T *A##_emplace_front(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        if(!vec->first) { \
+            /* keep the items at the start of the buffer, like a string */ \
+            if(VEC_KEEP_ZERO_END) return A##_emplace_at(vec, 0); \
+            if(A##_static_headroom(vec)) return 0; \
+        } \
+        size_t front = --vec->first; \
+        T *item = VEC_REF(M) *A##_static_get(vec, front); \
+        if(F != 0) { \
+            VEC_TYPE_FREE(F, item, T); /* in case we popped the front (but didn't free) */ \
+            vec_memset(item, 0, sizeof(T)); \
+        } \
+        A##_static_zero_end(vec); \
+        return item; \
+    }
+
+/**
+ * @brief A##_emplace_back [COMMON] - add one slot to the back
  * @param vec - the vector
- * @param index - the certain index
- * @param val - the value (by reference) to overwrite said index with
- * @return void
+ * @return pointer to the new item (the body, for BY_REF) to construct in place, zeroed if there is a free function; 0 if failure
  */
-#define VEC_IMPLEMENT_COMMON_SET_AT(N, A, T, F, M) \
-    inline void A##_set_at(N *vec, size_t index, VEC_ITEM(T, M) val) \
+#define VEC_IMPLEMENT_COMMON_EMPLACE_BACK(N, A, T, F, M) \
+    inline T *A##_emplace_back(N *vec) \
     { \
         VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT(val, M); \
-        T *item = VEC_REF(M) *A##_static_get(vec, index + vec->first); \
-        if(F != 0) VEC_TYPE_FREE(F, item, T); \
-        vec_memcpy(item, VEC_REF(M) val, sizeof(T)); \
+        if(A##_reserve(vec, vec->last + 1)) return 0; \
+        size_t back = vec->last++; \
+        T *item = VEC_REF(M) *A##_static_get(vec, back); \
+        if(F != 0) { \
+            VEC_TYPE_FREE(F, item, T); /* in case we popped the back (but didn't free) */ \
+            vec_memset(item, 0, sizeof(T)); \
+        } \
+        A##_static_zero_end(vec); \
+        return item; \
     }
 
 /**
- * @brief A##_pop_at [COMMON] - pop one item from the back (and adjust length)
+ * @brief A##_emplace_at [COMMON] - add one slot at index and move everything back
  * @param vec - the vector
- * @param index - the index
- * @param val - write back for popped value, pass 0 to ignore
- * @return void
+ * @param index - the index, up to the length
+ * @return pointer to the new item (the body, for BY_REF) to construct in place, zeroed if there is a free function; 0 if failure
  */
-#define VEC_IMPLEMENT_COMMON_POP_AT(N, A, T, F, M) \
-    inline void A##_pop_at(N *vec, size_t index, T *val) \
+#define VEC_IMPLEMENT_COMMON_EMPLACE_AT(N, A, T, F, M) \
+    inline T *A##_emplace_at(N *vec, size_t index) \
     { \
         VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT(val, M); \
-        VEC_ITEM(T, M) *item = A##_static_get(vec, index + vec->first); \
-        if(val) { \
-            vec_memcpy(val, VEC_REF(M) *item, sizeof(T)); \
+        if(A##_static_open(vec, index, 1)) return 0; \
+        T *item = VEC_REF(M) *A##_static_get(vec, index + vec->first); \
+        if(F != 0) { \
+            VEC_TYPE_FREE(F, item, T); /* in case we popped it (but didn't free) */ \
+            vec_memset(item, 0, sizeof(T)); \
         } \
-        vec->last--; \
-        vec_memmove(item, item + 1, sizeof(*item) * (vec->last - index - vec->first)); \
-        return; \
+        A##_static_zero_end(vec); \
+        return item; \
     }
 
 /**
@@ -645,17 +1896,14 @@ typedef enum
     { \
         VEC_ASSERT_REAL(vec); \
         VEC_ASSERT(val, M); \
-        int result = A##_reserve(vec, vec->last + 1); \
-        if(result) return result; \
-        vec->last++; \
-        VEC_ITEM(T, M) *item = A##_static_get(vec, index + vec->first); \
-        vec_memmove(item + 1, item, sizeof(*item) * (vec->last - index - vec->first - 1)); \
-        vec_memcpy(VEC_REF(M) *item, VEC_REF(M) val, sizeof(T)); \
+        T *item = A##_emplace_at(vec, index); \
+        if(!item) return VEC_ERROR_MALLOC; \
+        vec_memcpy(item, VEC_REF(M) val, sizeof(T)); \
         return VEC_ERROR_NONE; \
     }
 
 /**
- * @brief A##_push_front [COMMON] - push one item from the front and move everything back
+ * @brief A##_push_front [COMMON] - push one item to the front, into the room left in front of the first item (made if there is none, except with VEC_KEEP_ZERO_END, where the items get moved back so the raw items still point at the first one)
  * @param vec - the vector
  * @param val - the value (by reference) to be pushed
  * @return zero if success, non-zero if failure
@@ -665,12 +1913,17 @@ typedef enum
     { \
         VEC_ASSERT_REAL(vec); \
         VEC_ASSERT(val, M); \
-        int result = A##_reserve(vec, vec->last + 1); \
-        if(result) return result; \
-        size_t len = vec->last++ - vec->first; \
-        VEC_ITEM(T, M) *item = A##_static_get(vec, vec->first); \
-        vec_memmove(item + 1, item, sizeof(*item) * len); \
-        vec_memcpy(VEC_REF(M) *item, VEC_REF(M) val, sizeof(T)); \
+        if(!vec->first) { \
+            /* keep the items at the start of the buffer, like a string */ \
+            if(VEC_KEEP_ZERO_END) return A##_push_at(vec, 0, val); \
+            int result = A##_static_headroom(vec); \
+            if(result) return result; \
+        } \
+        size_t front = --vec->first; \
+        T *item = VEC_REF(M) *A##_static_get(vec, front); \
+        if(F != 0) VEC_TYPE_FREE(F, item, T); /* in case we popped the front (but didn't free) */ \
+        vec_memcpy(item, VEC_REF(M) val, sizeof(T)); \
+        A##_static_zero_end(vec); \
         return VEC_ERROR_NONE; \
     }
 
@@ -692,6 +1945,64 @@ typedef enum
         /* TODO add a new parameter: clearing function! so we don't free this! => we'll still overwrite 2 linew below... */ \
         if(F != 0) VEC_TYPE_FREE(F, item, T); /* required (?) in case we pop back (but don't free (?)) and then push back again */ \
         vec_memcpy(item, VEC_REF(M) val, sizeof(T)); \
+        A##_static_zero_end(vec); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_push_front_n [COMMON] - push copies of an array to the front, reserving once (into the room left in front of the first item, if there is enough)
+ * @param vec - the vector
+ * @param vals - the items (by value, also for BY_REF)
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_PUSH_FRONT_N(N, A, T, F, M) \
+    inline int A##_push_front_n(N *vec, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(vals || !n); \
+        if(vec->first >= n) { \
+            vec->first -= n; \
+        } else { \
+            int result = A##_static_open(vec, 0, n); \
+            if(result) return result; \
+        } \
+        A##_static_fill_raw(vec, 0, vals, n); \
+        A##_static_zero_end(vec); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_push_back_n [COMMON] - push copies of an array to the back, reserving once
+ * @param vec - the vector
+ * @param vals - the items (by value, also for BY_REF)
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_PUSH_BACK_N(N, A, T, F, M) \
+    inline int A##_push_back_n(N *vec, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return A##_push_at_n(vec, A##_length(vec), vals, n); \
+    }
+
+/**
+ * @brief A##_push_at_n [COMMON] - insert copies of an array at index and move everything back, reserving once
+ * @param vec - the vector
+ * @param index - the index, up to the length
+ * @param vals - the items (by value, also for BY_REF)
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_PUSH_AT_N(N, A, T, F, M) \
+    inline int A##_push_at_n(N *vec, size_t index, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(vals || !n); \
+        int result = A##_static_open(vec, index, n); \
+        if(result) return result; \
+        A##_static_fill_raw(vec, index, vals, n); \
+        A##_static_zero_end(vec); \
         return VEC_ERROR_NONE; \
     }
 
@@ -714,6 +2025,29 @@ typedef enum
         vec_memcpy(v2, &tmp, sizeof(tmp)); \
     }
 
+/**
+ * @brief A##_reverse_slice [COMMON] - reverse n items starting at an index, in blocks for items of 1, 2, 4 or 8 bytes (always for BY_REF, which reverses the references)
+ * @param vec - the vector
+ * @param from - the index
+ * @param n - number of items, from + n up to the length
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_REVERSE_SLICE(N, A, T, F, M) \
+    inline void A##_reverse_slice(N *vec, size_t from, size_t n) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(from + n <= A##_length(vec)); \
+        if(n < 2) return; \
+        VEC_ITEM(T, M) *item = &vec->VEC_STRUCT_ITEMS[vec->first + from]; \
+        if(vec_reverse_kernel(item, n, sizeof(*item))) return; \
+        VEC_ITEM(T, M) tmp; \
+        for(size_t i = 0, j = n - 1; i < j; i++, j--) { \
+            vec_memcpy(&tmp, &item[i], sizeof(tmp)); \
+            vec_memcpy(&item[i], &item[j], sizeof(tmp)); \
+            vec_memcpy(&item[j], &tmp, sizeof(tmp)); \
+        } \
+    }
+
 /**
  * @brief A##_reverse [COMMON] - reverse a vector
  * @param vec - the vector
@@ -723,11 +2057,7 @@ typedef enum
     inline void A##_reverse(N *vec) \
     { \
         VEC_ASSERT_REAL(vec); \
-        size_t len = A##_length(vec); \
-        size_t len2 = len / 2; \
-        for(size_t i = 0; i < len2; i++) { \
-            A##_swap(vec, i, len - i - 1); \
-        } \
+        A##_reverse_slice(vec, 0, A##_length(vec)); \
     }
 
 /* implementation by value */
@@ -746,8 +2076,12 @@ typedef enum
                 VEC_TYPE_FREE(F, &vec->VEC_STRUCT_ITEMS[i], T); \
             } \
         } \
-        free(vec->VEC_STRUCT_ITEMS); \
+        if(!A##_static_inline(vec)) { \
+            A##_static_free(vec, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * vec->cap); \
+        } \
+        const VecAllocator *allocator = vec->allocator; \
         A##_static_zero(vec); \
+        vec->allocator = allocator; \
     }
 
 /**
@@ -772,6 +2106,7 @@ typedef enum
     { \
         VEC_ASSERT_REAL(vec); \
         size_t result = 0; \
+        if(A##_static_inline(vec)) return result; \
         result += (sizeof(*vec->VEC_STRUCT_ITEMS) * vec->cap); \
         return result; \
     }
@@ -786,17 +2121,45 @@ typedef enum
     inline int A##_reserve(N *vec, size_t cap) \
     { \
         VEC_ASSERT_REAL(vec); \
+        int result = A##_static_compact(vec, &cap); \
+        if(result) return result; \
         cap += VEC_KEEP_ZERO_END; \
         size_t cap_is = vec->cap; \
         if(cap > cap_is) { \
-            size_t required = vec->cap ? vec->cap : VEC_DEFAULT_SIZE;\
-            while(required < cap) required *= 2; \
+            size_t required = A##_static_growth(vec->cap, cap); \
             if(required > vec->cap) { \
-                void *temp = vec_realloc(vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
-                if(!temp) return VEC_ERROR_REALLOC; \
+                /* free routines rely on zeroed items, so only skip zeroing without one */ \
+                int zero = VEC_ZERO_INIT || F != 0; \
+                size_t inline_cap = VEC_INLINE_CAP; \
+                void *temp = 0; \
+                if(required <= inline_cap) { \
+                    /* small enough for the inline storage */ \
+                    required = inline_cap; \
+                    temp = VEC_INLINE_ITEMS(vec, BY_VAL); \
+                    if(zero) vec_memset(temp, 0, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
+                    zero = 0; \
+                } else if(A##_static_inline(vec) || (zero && !vec->VEC_STRUCT_ITEMS)) { \
+                    temp = zero ? A##_static_calloc(vec, sizeof(*vec->VEC_STRUCT_ITEMS) * required) \
+                                : A##_static_malloc(vec, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
+                    if(!temp) return VEC_ERROR_MALLOC; \
+                    if(cap_is) A##_static_memcpy(temp, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * cap_is); \
+                    zero = 0; \
+                } else { \
+                    temp = A##_static_realloc(vec, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * cap_is, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
+                    if(!temp) return VEC_ERROR_REALLOC; \
+                } \
                 vec->VEC_STRUCT_ITEMS = temp; \
-                vec_memset(&vec->VEC_STRUCT_ITEMS[cap_is], 0, sizeof(*vec->VEC_STRUCT_ITEMS) * (required - cap_is)); \
+                if(zero) { \
+                    size_t from = sizeof(*vec->VEC_STRUCT_ITEMS) * cap_is; \
+                    size_t until = sizeof(*vec->VEC_STRUCT_ITEMS) * required; \
+                    /* pages freshly mapped are zero already */ \
+                    VecMapped mapped = A##_static_mapped(vec, until); \
+                    if(mapped && vec_mapped_size(mapped, from) < until) until = vec_mapped_size(mapped, from); \
+                    vec_memset((unsigned char *)vec->VEC_STRUCT_ITEMS + from, 0, until - from); \
+                } \
                 vec->cap = required; \
+                VEC_STATS_PEAK(A, required); \
+                A##_static_zero_end(vec); \
             } \
         } \
         return VEC_ERROR_NONE; \
@@ -818,8 +2181,10 @@ typedef enum
         if(A##_length(src)) { \
             int result = A##_reserve(dst, A##_length(src)); \
             if(result) return result; \
-            vec_memcpy(dst->VEC_STRUCT_ITEMS, src->VEC_STRUCT_ITEMS, sizeof(*dst->VEC_STRUCT_ITEMS) * A##_length(src)); \
+            /* the items start at first, there may be room in front of them */ \
+            A##_static_memcpy(dst->VEC_STRUCT_ITEMS, A##_iter_begin(src), sizeof(*dst->VEC_STRUCT_ITEMS) * A##_length(src)); \
             dst->last = A##_length(src); \
+            A##_static_zero_end(dst); \
         } \
         return VEC_ERROR_NONE; \
     }
@@ -840,10 +2205,17 @@ typedef enum
             if(F != 0) { \
                 VEC_TYPE_FREE(F, vec->VEC_STRUCT_ITEMS[i], T); \
             } \
-            free(vec->VEC_STRUCT_ITEMS[i]); \
+            if(!VEC_SLAB) A##_static_free(vec, vec->VEC_STRUCT_ITEMS[i], sizeof(**vec->VEC_STRUCT_ITEMS)); \
         } \
-        free(vec->VEC_STRUCT_ITEMS); \
+        while(vec->slabs) { \
+            VecSlab *next = vec->slabs->next; \
+            A##_static_free(vec, vec->slabs, vec->slabs->size); \
+            vec->slabs = next; \
+        } \
+        A##_static_free(vec, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * vec->cap); \
+        const VecAllocator *allocator = vec->allocator; \
         A##_static_zero(vec); \
+        vec->allocator = allocator; \
     }
 
 /**
@@ -886,21 +2258,38 @@ typedef enum
     inline int A##_reserve(N *vec, size_t cap) \
     { \
         VEC_ASSERT_REAL(vec); \
+        int result = A##_static_compact(vec, &cap); \
+        if(result) return result; \
         cap += VEC_KEEP_ZERO_END; \
         size_t cap_is = vec->cap; \
-        size_t required = vec->cap ? vec->cap : VEC_DEFAULT_SIZE;\
-        while(required < cap) required *= 2; \
+        size_t required = A##_static_growth(vec->cap, cap); \
         if(required > vec->cap) { \
-            void *temp = vec_realloc(vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
+            void *temp = A##_static_realloc(vec, vec->VEC_STRUCT_ITEMS, sizeof(*vec->VEC_STRUCT_ITEMS) * cap_is, sizeof(*vec->VEC_STRUCT_ITEMS) * required); \
             if(!temp) return VEC_ERROR_REALLOC; \
             vec->VEC_STRUCT_ITEMS = temp; \
-            vec_memset(&vec->VEC_STRUCT_ITEMS[cap_is], 0, sizeof(*vec->VEC_STRUCT_ITEMS) * (required - cap_is)); \
-            for(size_t i = cap_is; i < required; i++) { \
-                vec->VEC_STRUCT_ITEMS[i] = vec_malloc(sizeof(**vec->VEC_STRUCT_ITEMS)); \
-                if(!vec->VEC_STRUCT_ITEMS[i]) return VEC_ERROR_MALLOC; \
-                vec_memset(vec->VEC_STRUCT_ITEMS[i], 0, sizeof(**vec->VEC_STRUCT_ITEMS)); \
+            int zero = VEC_ZERO_INIT || F != 0; \
+            if(VEC_SLAB) { \
+                /* carve all new bodies from one slab */ \
+                size_t bodies = sizeof(**vec->VEC_STRUCT_ITEMS) * (required - cap_is); \
+                VecSlab *slab = A##_static_malloc(vec, sizeof(VecSlab) + bodies); \
+                if(!slab) return VEC_ERROR_MALLOC; \
+                slab->next = vec->slabs; \
+                slab->size = sizeof(VecSlab) + bodies; \
+                vec->slabs = slab; \
+                if(zero) vec_memset(slab->bodies, 0, bodies); \
+                T *body = (T *)slab->bodies; \
+                for(size_t i = cap_is; i < required; i++) { \
+                    vec->VEC_STRUCT_ITEMS[i] = body++; \
+                } \
+            } else { \
+                for(size_t i = cap_is; i < required; i++) { \
+                    vec->VEC_STRUCT_ITEMS[i] = A##_static_malloc(vec, sizeof(**vec->VEC_STRUCT_ITEMS)); \
+                    if(!vec->VEC_STRUCT_ITEMS[i]) return VEC_ERROR_MALLOC; \
+                    if(zero) vec_memset(vec->VEC_STRUCT_ITEMS[i], 0, sizeof(**vec->VEC_STRUCT_ITEMS)); \
+                } \
             } \
             vec->cap = required; \
+            VEC_STATS_PEAK(A, required); \
         } \
         return VEC_ERROR_NONE; \
     }
@@ -929,207 +2318,365 @@ typedef enum
         return result; \
     }
 
-#define VEC_IMPLEMENT_COMMON_EXTEND_FRONT(N, A, T, F, M) \
-    int A##_extend_front(N *vec, N *v2, size_t n) { \
+/**
+ * @brief A##_move [COMMON] - free a vector and hand it all memory of another one, O(1)
+ * @param dst - the destination vector
+ * @param src - the source vector, empty afterwards (keeping its allocator)
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_MOVE(N, A, T, F) \
+    inline void A##_move(N *dst, N *src) \
+    { \
+        VEC_ASSERT_REAL(dst); \
+        VEC_ASSERT_REAL(src); \
+        VEC_ASSERT_REAL(dst != src); \
+        A##_free(dst); \
+        *dst = *src; \
+        A##_static_relink(dst); \
+        const VecAllocator *allocator = src->allocator; \
+        A##_static_zero(src); \
+        src->allocator = allocator; \
+    }
+
+/**
+ * @brief A##_swap_vectors [COMMON] - swap all memory of two vectors, O(1)
+ * @param a - vector a
+ * @param b - vector b
+ * @return void
+ */
+#define VEC_IMPLEMENT_COMMON_SWAP_VECTORS(N, A, T, F) \
+    inline void A##_swap_vectors(N *a, N *b) \
+    { \
+        VEC_ASSERT_REAL(a); \
+        VEC_ASSERT_REAL(b); \
+        N temp = *a; \
+        *a = *b; \
+        *b = temp; \
+        A##_static_relink(a); \
+        A##_static_relink(b); \
+    }
+
+/**
+ * @brief A##_detach [BY_VAL] - take the items out as memory to be freed with vec_free, leaving the vector empty; O(1) unless there is room in front of the first item or the memory isn't plain (allocator, mapping, alignment, inline), then it's moved or copied
+ * @param vec - the vector
+ * @param len - write back for the number of items
+ * @return the items (followed by the VEC_KEEP_ZERO_END zero items), 0 if there were none (the vector is freed) or failure (the vector is left as is)
+ */
+#define VEC_IMPLEMENT_BY_VAL_DETACH(N, A, T, F) \
+    inline T *A##_detach(N *vec, size_t *len) \
+    { \
         VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
-        size_t until = n < A##_length(v2) ? n : A##_length(v2); \
-        size_t require = vec->last + A##_length(v2); \
-        int result = A##_reserve(vec, require); \
-        if(result) return result; \
-        vec->last += until; \
-        VEC_ITEM(T, M) *item = A##_static_get(vec, vec->first); \
-        vec_memmove(item + until, item, sizeof(*item) * (vec->last - until - vec->first)); \
-        /* TODO dangerous! memmove will not zero out the original memory bytes !!! */ \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) value = A##_get_at(v2, i); \
-            A##_set_at(vec, i, value); \
+        VEC_ASSERT_REAL(len); \
+        size_t n = A##_length(vec); \
+        T *items = 0; \
+        *len = 0; \
+        if(!n) { \
+            A##_free(vec); \
+            return 0; \
         } \
-        return VEC_ERROR_NONE; \
+        if(!A##_static_inline(vec) && A##_static_plain(vec, sizeof(T) * vec->cap) && vec->last + VEC_KEEP_ZERO_END <= vec->cap) { \
+            items = vec->VEC_STRUCT_ITEMS; \
+        } else { \
+            items = vec_malloc(sizeof(T) * (n + VEC_KEEP_ZERO_END)); \
+            if(!items) return 0; \
+        } \
+        if(F != 0) { \
+            /* the popped (but not freed) items stay behind */ \
+            for(size_t i = 0; i < vec->first; i++) VEC_TYPE_FREE(F, &vec->VEC_STRUCT_ITEMS[i], T); \
+            for(size_t i = vec->last; i < vec->cap; i++) VEC_TYPE_FREE(F, &vec->VEC_STRUCT_ITEMS[i], T); \
+        } \
+        if(items == vec->VEC_STRUCT_ITEMS) { \
+            if(vec->first) A##_static_memmove(items, items + vec->first, sizeof(T) * n); \
+        } else { \
+            if(n) A##_static_memcpy(items, vec->VEC_STRUCT_ITEMS + vec->first, sizeof(T) * n); \
+            if(!A##_static_inline(vec)) A##_static_free(vec, vec->VEC_STRUCT_ITEMS, sizeof(T) * vec->cap); \
+        } \
+        if(VEC_KEEP_ZERO_END) vec_memset(items + n, 0, sizeof(T) * VEC_KEEP_ZERO_END); \
+        const VecAllocator *allocator = vec->allocator; \
+        A##_static_zero(vec); \
+        vec->allocator = allocator; \
+        *len = n; \
+        return items; \
+    }
+
+/**
+ * @brief A##_adopt [BY_VAL] - free the vector and take over memory allocated with vec_malloc as its items; O(1) unless the vector needs its memory to be allocated differently (allocator, mapping, alignment) or the zero end doesn't fit, then it's copied
+ * @param vec - the vector
+ * @param items - the items, owned by the vector afterwards
+ * @param len - number of items
+ * @param cap - number of item spaces allocated
+ * @return zero if success, non-zero if failure (the items are freed either way)
+ */
+#define VEC_IMPLEMENT_BY_VAL_ADOPT(N, A, T, F) \
+    inline int A##_adopt(N *vec, T *items, size_t len, size_t cap) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(items || !cap); \
+        VEC_ASSERT_REAL(len <= cap); \
+        A##_free(vec); \
+        if(cap && A##_static_plain(vec, sizeof(T) * cap) && len + VEC_KEEP_ZERO_END <= cap && cap > VEC_INLINE_CAP) { \
+            /* capacities up to the inline one are taken for inline storage, don't hand those over */ \
+            /* free routines rely on zeroed items */ \
+            if(F != 0) vec_memset(items + len, 0, sizeof(T) * (cap - len)); \
+            vec->VEC_STRUCT_ITEMS = items; \
+            vec->cap = cap; \
+            vec->last = len; \
+            A##_static_zero_end(vec); \
+            return VEC_ERROR_NONE; \
+        } \
+        int result = A##_push_back_n(vec, items, len); \
+        vec_free(items); \
+        return result; \
+    }
+
+/**
+ * @brief A##_detach [BY_REF] - copy the items out into memory to be freed with vec_free and free the vector, O(n) since the bodies are allocated one by one
+ * @param vec - the vector
+ * @param len - write back for the number of items
+ * @return the items, 0 if there were none (the vector is freed) or failure (the vector is left as is)
+ */
+#define VEC_IMPLEMENT_BY_REF_DETACH(N, A, T, F) \
+    inline T *A##_detach(N *vec, size_t *len) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(len); \
+        size_t n = A##_length(vec); \
+        *len = 0; \
+        if(!n) { \
+            A##_free(vec); \
+            return 0; \
+        } \
+        T *items = vec_malloc(sizeof(T) * n); \
+        if(!items) return 0; \
+        for(size_t i = 0; i < n; i++) { \
+            T *body = vec->VEC_STRUCT_ITEMS[vec->first + i]; \
+            vec_memcpy(&items[i], body, sizeof(T)); \
+            /* owned by the copy now */ \
+            vec_memset(body, 0, sizeof(T)); \
+        } \
+        A##_free(vec); \
+        *len = n; \
+        return items; \
+    }
+
+/**
+ * @brief A##_adopt [BY_REF] - free the vector and take over the items of memory allocated with vec_malloc, copying them into bodies, O(n)
+ * @param vec - the vector
+ * @param items - the items, freed afterwards
+ * @param len - number of items
+ * @param cap - number of item spaces allocated
+ * @return zero if success, non-zero if failure (the items are freed either way)
+ */
+#define VEC_IMPLEMENT_BY_REF_ADOPT(N, A, T, F) \
+    inline int A##_adopt(N *vec, T *items, size_t len, size_t cap) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(items || !cap); \
+        VEC_ASSERT_REAL(len <= cap); \
+        (void) cap; \
+        A##_free(vec); \
+        int result = A##_push_back_n(vec, items, len); \
+        vec_free(items); \
+        return result; \
+    }
+
+/**
+ * @brief A##_extend_front [COMMON] - insert copies of the first n items of another vector in the front
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length of v2
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_IMPLEMENT_COMMON_EXTEND_FRONT(N, A, T, F, M) \
+    int A##_extend_front(N *vec, N *v2, size_t n) { \
+        return A##_extend_at(vec, 0, v2, n); \
     }
 
+/**
+ * @brief A##_extend_back [COMMON] - append copies of the first n items of another vector
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length of v2
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_EXTEND_BACK(N, A, T, F, M) \
     int A##_extend_back(N *vec, N *v2, size_t n) { \
         VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
-        size_t until = n < A##_length(v2) ? n : A##_length(v2); \
-        size_t require = vec->last + A##_length(v2); \
-        size_t from = require < A##_length(vec) ? A##_length(vec) - require : 0; \
-        int result = A##_reserve(vec, require); \
-        if(result) return result; \
-        vec->last += until; \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) value = A##_get_at(v2, i); \
-            A##_set_at(vec, from + i, value); \
-        } \
-        return VEC_ERROR_NONE; \
+        return A##_extend_at(vec, A##_length(vec), v2, n); \
     }
 
+/**
+ * @brief A##_extend_at [COMMON] - insert copies of the first n items of another vector at index
+ * @param vec - the vector
+ * @param index - the index, up to the length
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length of v2
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_EXTEND_AT(N, A, T, F, M) \
     int A##_extend_at(N *vec, size_t index, N *v2, size_t n) { \
         VEC_ASSERT_REAL(vec); \
         VEC_ASSERT_REAL(v2); \
+        VEC_ASSERT_REAL(vec != v2); \
         size_t until = n < A##_length(v2) ? n : A##_length(v2); \
-        size_t require = vec->last + A##_length(v2); \
-        int result = A##_reserve(vec, require); \
+        int result = A##_static_open(vec, index, until); \
         if(result) return result; \
-        vec->last += until; \
-        VEC_ITEM(T, M) *item = A##_static_get(vec, index + vec->first); \
-        vec_memmove(item + until, item, sizeof(*item) * (vec->last - index - until - vec->first)); \
-        /* TODO dangerous! memmove will not zero out the original memory bytes !!! */ \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) value = A##_get_at(v2, i); \
-            A##_set_at(vec, index + i, value); \
-        } \
+        A##_static_fill(vec, index, A##_iter_begin(v2), until); \
+        A##_static_zero_end(vec); \
         return VEC_ERROR_NONE; \
     }
 
+/**
+ * @brief A##_cut_front [COMMON] - move the first n items to the back of another vector
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_CUT_FRONT(N, A, T, F, M) \
     int A##_cut_front(N *vec, N *v2, size_t n) { \
-        VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
-        size_t until = n < A##_length(vec) ? n : A##_length(vec); \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) *value = A##_static_get(vec, vec->first + i); \
-            int result = A##_push_back(v2, *value); \
-            if(result) return result; \
-        } \
-        vec->first += until; \
-        return VEC_ERROR_NONE; \
+        return A##_cut_at(vec, 0, n, v2); \
     }
 
+/**
+ * @brief A##_cut_back [COMMON] - move the last n items to the back of another vector
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_CUT_BACK(N, A, T, F, M) \
     int A##_cut_back(N *vec, N *v2, size_t n) { \
         VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
         size_t from = n < A##_length(vec) ? A##_length(vec) - n : 0; \
-        size_t until = n < A##_length(vec) ? n : A##_length(vec); \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) *value = A##_static_get(vec, vec->first + i + from); /* optimization of this could also be interesting */ \
-            int result = A##_push_back(v2, *value); \
-            if(result) return result; \
-        } \
-        vec->last -= until; \
-        return VEC_ERROR_NONE; \
+        return A##_cut_at(vec, from, n, v2); \
     }
 
+/**
+ * @brief A##_cut_at [COMMON] - move n items starting at index to the back of another vector
+ * @param vec - the vector
+ * @param from - the index
+ * @param n - number of items, up to the ones from index on
+ * @param v2 - the other vector
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_CUT_AT(N, A, T, F, M) \
     int A##_cut_at(N *vec, size_t from, size_t n, N *v2) { \
         VEC_ASSERT_REAL(vec); \
         VEC_ASSERT_REAL(v2); \
-        VEC_ASSERT_REAL(0 && "todo: implement"); \
-        (void) from; \
-        (void) n; \
-        return 0; \
-    }
-
-#if 0
-        VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
-        size_t until = n < A##_length(vec) ? n : A##_length(vec); \
-        VEC_ITEM(T, M) *item = A##_static_get(vec, from + vec->first); \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) value = A##_get_at(vec, from + i); \
-            int result = A##_push_back(v2, value); \
-            if(result) return result; \
-        } \
-        if(VEC_IS_BY_REF(M) || F != 0) /* TODO actually confirm how this is optimized in higher levels of optimization */ { \
-            /* similar to shrink front, we have to preserve all items, since they're alloced */ \
-            /* TODO however, we don't want to keep any item data! we NEED to 0 it out, because v2' free will otherwise cause a dual free, in combination with vec's free... */ \
-            VEC_ITEM(T, M) *residuals = malloc(sizeof(*residuals) * until); \
-            if(!residuals) return VEC_ERROR_MALLOC; \ vec_memcpy(residuals, item, sizeof(*residuals) * until); \
-            vec_memmove(item, item + until, sizeof(*item) * (vec->last - from)); \
-            vec_memcpy(item + vec->last - until, residuals, sizeof(*residuals) * until); \
-        } else { \
-            vec_memmove(item, item + until, sizeof(*item) * (vec->last - from)); \
-        } \
-        vec->last -= until; \
-        return VEC_ERROR_NONE; \
+        VEC_ASSERT_REAL(vec != v2); \
+        VEC_ASSERT_REAL(from <= A##_length(vec)); \
+        size_t until = n < A##_length(vec) - from ? n : A##_length(vec) - from; \
+        size_t back = A##_length(v2); \
+        int result = A##_static_open(v2, back, until); \
+        if(result) return result; \
+        A##_static_fill(v2, back, A##_iter_at(vec, from), until); \
+        A##_static_zero_end(v2); \
+        return A##_static_close(vec, from, until); \
     }
-#endif
 
+/**
+ * @brief A##_paste_front [COMMON] - overwrite the first items with copies of the first n items of another vector (growing if needed)
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length of v2
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_PASTE_FRONT(N, A, T, F, M) \
     int A##_paste_front(N *vec, N *v2, size_t n) { \
-        VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
-        size_t until = n < A##_length(v2) ? n : A##_length(v2); \
-        size_t require = until < A##_length(vec) ? until : A##_length(vec); \
-        int result = A##_reserve(vec, require); \
-        if(result) return result; \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) value = A##_get_at(v2, i); \
-            A##_set_at(vec, i, value); \
-        } \
-        return VEC_ERROR_NONE; \
+        return A##_paste_at(vec, 0, v2, n); \
     }
 
+/**
+ * @brief A##_paste_back [COMMON] - overwrite the last items with copies of the first n items of another vector (growing if needed)
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length of v2
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_PASTE_BACK(N, A, T, F, M) \
     int A##_paste_back(N *vec, N *v2, size_t n) { \
         VEC_ASSERT_REAL(vec); \
         VEC_ASSERT_REAL(v2); \
         size_t until = n < A##_length(v2) ? n : A##_length(v2); \
-        size_t require = until < A##_length(vec) ? until : A##_length(vec); \
         size_t from = until < A##_length(vec) ? A##_length(vec) - until : 0; \
-        int result = A##_reserve(vec, require); \
-        if(result) return result; \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) value = A##_get_at(v2, i); \
-            A##_set_at(vec, from + i, value); \
-        } \
-        return VEC_ERROR_NONE; \
+        return A##_paste_at(vec, from, v2, until); \
     }
 
+/**
+ * @brief A##_paste_at [COMMON] - overwrite items starting at index with copies of the first n items of another vector (growing if needed)
+ * @param vec - the vector
+ * @param index - the index, up to the length
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length of v2
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_PASTE_AT(N, A, T, F, M) \
     int A##_paste_at(N *vec, size_t index, N *v2, size_t n) { \
         VEC_ASSERT_REAL(vec); \
         VEC_ASSERT_REAL(v2); \
-        VEC_ASSERT_REAL(0 && "todo: implement"); \
-        (void) n; \
-        (void) index; \
-        return 0; \
+        VEC_ASSERT_REAL(vec != v2); \
+        VEC_ASSERT_REAL(index <= A##_length(vec)); \
+        size_t until = n < A##_length(v2) ? n : A##_length(v2); \
+        size_t len = A##_length(vec); \
+        if(index + until > len) { \
+            int result = A##_static_open(vec, len, index + until - len); \
+            if(result) return result; \
+        } \
+        A##_static_fill(vec, index, A##_iter_begin(v2), until); \
+        A##_static_zero_end(vec); \
+        return VEC_ERROR_NONE; \
     }
 
+/**
+ * @brief A##_cat_front [COMMON] - append copies of the first n items to another vector
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_CAT_FRONT(N, A, T, F, M) \
     int A##_cat_front(N *vec, N *v2, size_t n) { \
-        VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
-        size_t until = n < A##_length(vec) ? n : A##_length(vec); \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) *item = A##_static_get(vec, vec->first + i); \
-            int result = A##_push_back(v2, *item); \
-            if(result) return result; \
-        } \
-        return VEC_ERROR_NONE; \
+        return A##_cat_at(vec, 0, n, v2); \
     }
 
+/**
+ * @brief A##_cat_back [COMMON] - append copies of the last n items to another vector
+ * @param vec - the vector
+ * @param v2 - the other vector
+ * @param n - number of items, up to the length
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_CAT_BACK(N, A, T, F, M) \
     int A##_cat_back(N *vec, N *v2, size_t n) { \
         VEC_ASSERT_REAL(vec); \
-        VEC_ASSERT_REAL(v2); \
         size_t from = n < A##_length(vec) ? A##_length(vec) - n : 0; \
-        size_t until = n < A##_length(vec) ? n : A##_length(vec); \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) *item = A##_static_get(vec, vec->first + i + from); \
-            int result = A##_push_back(v2, *item); \
-            if(result) return result; \
-        } \
-        return VEC_ERROR_NONE; \
+        return A##_cat_at(vec, from, n, v2); \
     }
 
+/**
+ * @brief A##_cat_at [COMMON] - append copies of n items starting at index to another vector
+ * @param vec - the vector
+ * @param from - the index
+ * @param n - number of items, up to the ones from index on
+ * @param v2 - the other vector
+ * @return zero if success, non-zero if failure
+ */
 #define VEC_IMPLEMENT_COMMON_CAT_AT(N, A, T, F, M) \
     int A##_cat_at(N *vec, size_t from, size_t n, N *v2) { \
         VEC_ASSERT_REAL(vec); \
         VEC_ASSERT_REAL(v2); \
-        size_t until = n < A##_length(vec) ? n : A##_length(vec); \
-        for(size_t i = 0; i < until; i++) { \
-            VEC_ITEM(T, M) *item = A##_static_get(vec, vec->first + i + from); \
-            int result = A##_push_back(v2, *item); \
-            if(result) return result; \
-        } \
+        VEC_ASSERT_REAL(vec != v2); \
+        VEC_ASSERT_REAL(from <= A##_length(vec)); \
+        size_t until = n < A##_length(vec) - from ? n : A##_length(vec) - from; \
+        size_t back = A##_length(v2); \
+        int result = A##_static_open(v2, back, until); \
+        if(result) return result; \
+        A##_static_fill(v2, back, A##_iter_at(vec, from), until); \
+        A##_static_zero_end(v2); \
         return VEC_ERROR_NONE; \
     }
 
-
 //#define VEC_H
 //#endif
 
@@ -0,0 +1,395 @@
+/* MIT License
+
+Copyright (c) 2023 rphii
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef VEC_GAP_H
+
+#include "vec.h"
+
+/*
+ * === THE GAP BUFFER DESCRIPTION ===
+ * the items live in one buffer that has a gap of unused slots at the cursor:
+ *      [0, gap_begin) items in front of the cursor
+ *      [gap_begin, gap_end) the gap
+ *      [gap_end, cap) items behind the cursor
+ * inserting and erasing at the cursor only moves the edges of the gap, and
+ * moving the cursor only moves the items in between the old and the new
+ * position, so clustered edits don't shift the whole tail like
+ * A##_push_at/A##_pop_at of the vector would. it pairs with a BY_VAL vector
+ * V (prefix VA), which it can be loaded from and flattened into. the settings
+ * of V (VEC_SETTINGS_DEFAULT_SIZE, VEC_SETTINGS_GROWTH, VEC_SETTINGS_KEEP_ZERO_END
+ * and VEC_SETTINGS_STRUCT_ITEMS) have to be set when including and
+ * implementing. items are copied in and out by value, so it's meant for plain
+ * data like characters.
+ */
+
+/**********************************************************/
+/* DECLARATION ********************************************/
+/**********************************************************/
+
+/*
+ * N = name - the name of the gap buffer struct
+ * A = abbreviation - the prefix of the functions
+ * T = type - the type of the items
+ * V = vector - the name of the BY_VAL vector struct of the same items
+ * VA = vector abbreviation - the prefix of the vector functions
+ */
+
+#define VEC_GAP_INCLUDE(N, A, T, V) \
+    typedef struct N { \
+        size_t cap; \
+        size_t gap_begin; \
+        size_t gap_end; \
+        T *items; \
+    } N; \
+    \
+    void A##_clear(N *gap); \
+    size_t A##_length(const N *gap); \
+    size_t A##_capacity(const N *gap); \
+    size_t A##_cursor(const N *gap); \
+    int A##_reserve(N *gap, size_t cap); \
+    void A##_move_to(N *gap, size_t index); \
+    int A##_insert(N *gap, T val); \
+    int A##_insert_n(N *gap, const T *vals, size_t n); \
+    void A##_erase_before(N *gap, size_t n); \
+    void A##_erase_after(N *gap, size_t n); \
+    T A##_get_at(const N *gap, size_t index); \
+    T *A##_iter_at(const N *gap, size_t index); \
+    T *A##_data(N *gap); \
+    int A##_load(N *gap, const V *vec); \
+    int A##_flatten(const N *gap, V *vec); \
+    void A##_free(N *gap); \
+    void A##_zero(N *gap); \
+
+/**********************************************************/
+/* IMPLEMENTATION *****************************************/
+/**********************************************************/
+
+#define VEC_GAP_IMPLEMENT(N, A, T, V, VA) \
+    /* private */ \
+    VEC_GAP_IMPLEMENT_STATIC_GAP(N, A, T, V, VA);       \
+    /* public */ \
+    VEC_GAP_IMPLEMENT_CLEAR(N, A, T, V, VA);            \
+    VEC_GAP_IMPLEMENT_LENGTH(N, A, T, V, VA);           \
+    VEC_GAP_IMPLEMENT_CAPACITY(N, A, T, V, VA);         \
+    VEC_GAP_IMPLEMENT_CURSOR(N, A, T, V, VA);           \
+    VEC_GAP_IMPLEMENT_RESERVE(N, A, T, V, VA);          \
+    VEC_GAP_IMPLEMENT_MOVE_TO(N, A, T, V, VA);          \
+    VEC_GAP_IMPLEMENT_INSERT_N(N, A, T, V, VA);         \
+    VEC_GAP_IMPLEMENT_INSERT(N, A, T, V, VA);           \
+    VEC_GAP_IMPLEMENT_ERASE_BEFORE(N, A, T, V, VA);     \
+    VEC_GAP_IMPLEMENT_ERASE_AFTER(N, A, T, V, VA);      \
+    VEC_GAP_IMPLEMENT_ITER_AT(N, A, T, V, VA);          \
+    VEC_GAP_IMPLEMENT_GET_AT(N, A, T, V, VA);           \
+    VEC_GAP_IMPLEMENT_DATA(N, A, T, V, VA);             \
+    VEC_GAP_IMPLEMENT_LOAD(N, A, T, V, VA);             \
+    VEC_GAP_IMPLEMENT_FLATTEN(N, A, T, V, VA);          \
+    VEC_GAP_IMPLEMENT_FREE(N, A, T, V, VA);             \
+    VEC_GAP_IMPLEMENT_ZERO(N, A, T, V, VA);             \
+
+/**********************************************************/
+/* PRIVATE FUNCTION IMPLEMENTATIONS ***********************/
+/**********************************************************/
+
+/**
+ * @brief A##_static_gap - internal use, get the number of slots in the gap
+ * @param gap - the gap buffer
+ * @return number of slots
+ */
+#define VEC_GAP_IMPLEMENT_STATIC_GAP(N, A, T, V, VA) \
+    static inline size_t A##_static_gap(const N *gap) \
+    { \
+        return gap->gap_end - gap->gap_begin; \
+    }
+
+/**********************************************************/
+/* PUBLIC FUNCTION IMPLEMENTATIONS ************************/
+/**********************************************************/
+
+/**
+ * @brief A##_clear - remove all items, but keep the memory
+ * @param gap - the gap buffer
+ * @return void
+ */
+#define VEC_GAP_IMPLEMENT_CLEAR(N, A, T, V, VA) \
+    inline void A##_clear(N *gap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        gap->gap_begin = 0; \
+        gap->gap_end = gap->cap; \
+    }
+
+/**
+ * @brief A##_length - get the length (in items)
+ * @param gap - the gap buffer
+ * @return length in items
+ */
+#define VEC_GAP_IMPLEMENT_LENGTH(N, A, T, V, VA) \
+    inline size_t A##_length(const N *gap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        return gap->cap - A##_static_gap(gap); \
+    }
+
+/**
+ * @brief A##_capacity - get number of allocated item spaces (not in bytes)
+ * @param gap - the gap buffer
+ * @return capacity in item spaces
+ */
+#define VEC_GAP_IMPLEMENT_CAPACITY(N, A, T, V, VA) \
+    inline size_t A##_capacity(const N *gap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        return gap->cap; \
+    }
+
+/**
+ * @brief A##_cursor - get the index the next insert goes to
+ * @param gap - the gap buffer
+ * @return index of the cursor
+ */
+#define VEC_GAP_IMPLEMENT_CURSOR(N, A, T, V, VA) \
+    inline size_t A##_cursor(const N *gap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        return gap->gap_begin; \
+    }
+
+/**
+ * @brief A##_reserve - reserve memory for a certain minimum number of items (only expanding), widening the gap
+ * @param gap - the gap buffer
+ * @param cap - the minimum desired item capacity
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_GAP_IMPLEMENT_RESERVE(N, A, T, V, VA) \
+    inline int A##_reserve(N *gap, size_t cap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        cap += VEC_KEEP_ZERO_END; \
+        if(cap <= gap->cap) return VEC_ERROR_NONE; \
+        size_t required = gap->cap ? gap->cap : VEC_DEFAULT_SIZE; \
+        if(required < cap) required = VEC_GROWTH(required, cap, sizeof(T), VEC_GROWTH_PARAM); \
+        T *temp = vec_realloc(gap->items, sizeof(T) * required); \
+        if(!temp) return VEC_ERROR_REALLOC; \
+        /* the items behind the gap go to the end of the new memory */ \
+        size_t behind = gap->cap - gap->gap_end; \
+        vec_memmove(temp + required - behind, temp + gap->gap_end, sizeof(T) * behind); \
+        gap->items = temp; \
+        gap->gap_end = required - behind; \
+        gap->cap = required; \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_move_to - move the cursor (and with it the gap) to an index
+ * @param gap - the gap buffer
+ * @param index - the index, up to the length
+ * @return void
+ */
+#define VEC_GAP_IMPLEMENT_MOVE_TO(N, A, T, V, VA) \
+    inline void A##_move_to(N *gap, size_t index) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        VEC_ASSERT_REAL(index <= A##_length(gap)); \
+        if(index < gap->gap_begin) { \
+            size_t n = gap->gap_begin - index; \
+            vec_memmove(gap->items + gap->gap_end - n, gap->items + index, sizeof(T) * n); \
+            gap->gap_begin -= n; \
+            gap->gap_end -= n; \
+        } else if(index > gap->gap_begin) { \
+            size_t n = index - gap->gap_begin; \
+            vec_memmove(gap->items + gap->gap_begin, gap->items + gap->gap_end, sizeof(T) * n); \
+            gap->gap_begin += n; \
+            gap->gap_end += n; \
+        } \
+    }
+
+/**
+ * @brief A##_insert_n - insert items at the cursor, leaving the cursor behind them
+ * @param gap - the gap buffer
+ * @param vals - the items
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_GAP_IMPLEMENT_INSERT_N(N, A, T, V, VA) \
+    inline int A##_insert_n(N *gap, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        VEC_ASSERT_REAL(vals || !n); \
+        if(A##_static_gap(gap) < n + VEC_KEEP_ZERO_END) { \
+            int result = A##_reserve(gap, A##_length(gap) + n); \
+            if(result) return result; \
+        } \
+        if(n) vec_memcpy(gap->items + gap->gap_begin, vals, sizeof(T) * n); \
+        gap->gap_begin += n; \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_insert - insert one item at the cursor, leaving the cursor behind it
+ * @param gap - the gap buffer
+ * @param val - the item
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_GAP_IMPLEMENT_INSERT(N, A, T, V, VA) \
+    inline int A##_insert(N *gap, T val) \
+    { \
+        return A##_insert_n(gap, &val, 1); \
+    }
+
+/**
+ * @brief A##_erase_before - erase items in front of the cursor (like backspace)
+ * @param gap - the gap buffer
+ * @param n - number of items, at most the cursor
+ * @return void
+ */
+#define VEC_GAP_IMPLEMENT_ERASE_BEFORE(N, A, T, V, VA) \
+    inline void A##_erase_before(N *gap, size_t n) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        VEC_ASSERT_REAL(n <= gap->gap_begin); \
+        gap->gap_begin -= n; \
+    }
+
+/**
+ * @brief A##_erase_after - erase items behind the cursor (like delete)
+ * @param gap - the gap buffer
+ * @param n - number of items, at most the ones behind the cursor
+ * @return void
+ */
+#define VEC_GAP_IMPLEMENT_ERASE_AFTER(N, A, T, V, VA) \
+    inline void A##_erase_after(N *gap, size_t n) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        VEC_ASSERT_REAL(n <= gap->cap - gap->gap_end); \
+        gap->gap_end += n; \
+    }
+
+/**
+ * @brief A##_iter_at - get pointer to item at index, valid until the next edit or cursor move
+ * @param gap - the gap buffer
+ * @param index - the index
+ * @return pointer to item
+ */
+#define VEC_GAP_IMPLEMENT_ITER_AT(N, A, T, V, VA) \
+    inline T *A##_iter_at(const N *gap, size_t index) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        VEC_ASSERT_REAL(index < A##_length(gap)); \
+        if(index < gap->gap_begin) return &gap->items[index]; \
+        return &gap->items[index + A##_static_gap(gap)]; \
+    }
+
+/**
+ * @brief A##_get_at - get item at index
+ * @param gap - the gap buffer
+ * @param index - the index
+ * @return item
+ */
+#define VEC_GAP_IMPLEMENT_GET_AT(N, A, T, V, VA) \
+    inline T A##_get_at(const N *gap, size_t index) \
+    { \
+        return *A##_iter_at(gap, index); \
+    }
+
+/**
+ * @brief A##_data - get the items as one contiguous array, by moving the gap to the end (zero terminated by VEC_KEEP_ZERO_END items)
+ * @param gap - the gap buffer
+ * @return pointer to the first item, 0 if it couldn't reserve the zero end
+ */
+#define VEC_GAP_IMPLEMENT_DATA(N, A, T, V, VA) \
+    inline T *A##_data(N *gap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        size_t len = A##_length(gap); \
+        if(A##_reserve(gap, len)) return 0; \
+        A##_move_to(gap, len); \
+        if(VEC_KEEP_ZERO_END) vec_memset(gap->items + len, 0, sizeof(T) * VEC_KEEP_ZERO_END); \
+        return gap->items; \
+    }
+
+/**
+ * @brief A##_load - replace all items with the ones of a vector, the cursor ends up at the end
+ * @param gap - the gap buffer
+ * @param vec - the vector
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_GAP_IMPLEMENT_LOAD(N, A, T, V, VA) \
+    inline int A##_load(N *gap, const V *vec) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        VEC_ASSERT_REAL(vec); \
+        A##_clear(gap); \
+        return A##_insert_n(gap, VA##_iter_begin(vec), VA##_length(vec)); \
+    }
+
+/**
+ * @brief A##_flatten - copy all items into a vector, replacing its items (and keeping its zero end)
+ * @param gap - the gap buffer
+ * @param vec - the vector, with no free function
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_GAP_IMPLEMENT_FLATTEN(N, A, T, V, VA) \
+    inline int A##_flatten(const N *gap, V *vec) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        VEC_ASSERT_REAL(vec); \
+        size_t len = A##_length(gap); \
+        size_t behind = gap->cap - gap->gap_end; \
+        VA##_clear(vec); \
+        int result = VA##_reserve(vec, len); \
+        if(result) return result; \
+        T *items = VA##_iter_begin(vec); \
+        if(gap->gap_begin) vec_memcpy(items, gap->items, sizeof(T) * gap->gap_begin); \
+        if(behind) vec_memcpy(items + gap->gap_begin, gap->items + gap->gap_end, sizeof(T) * behind); \
+        vec->last = vec->first + len; \
+        if(VEC_KEEP_ZERO_END) vec_memset(VA##_iter_end(vec), 0, sizeof(T) * VEC_KEEP_ZERO_END); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_free - free the gap buffer
+ * @param gap - the gap buffer
+ * @return void
+ */
+#define VEC_GAP_IMPLEMENT_FREE(N, A, T, V, VA) \
+    inline void A##_free(N *gap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        vec_free(gap->items); \
+        A##_zero(gap); \
+    }
+
+/**
+ * @brief A##_zero - set the struct without freeing to zero
+ * @param gap - the gap buffer
+ * @return void
+ */
+#define VEC_GAP_IMPLEMENT_ZERO(N, A, T, V, VA) \
+    inline void A##_zero(N *gap) \
+    { \
+        VEC_ASSERT_REAL(gap); \
+        vec_memset(gap, 0, sizeof(*gap)); \
+    }
+
+#define VEC_GAP_H
+#endif
+
@@ -0,0 +1,246 @@
+/* MIT License
+
+Copyright (c) 2023 rphii
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef VEC_MPMC_H
+
+#include <stdatomic.h>
+
+#include "vec.h"
+
+/*
+ * === THE MPMC QUEUE DESCRIPTION ===
+ * a bounded, lock-free queue for any number of producer and consumer
+ * threads (after Dmitry Vyukov). every slot carries a sequence number:
+ * - seq == pos        the slot is free for the producer claiming pos
+ * - seq == pos + 1    the slot holds the item for the consumer claiming pos
+ * - after consuming, seq becomes pos + cap, freeing it for the next round
+ * producers and consumers claim positions by advancing their own counter
+ * (each on its own cache line) with a compare-and-swap; batches claim a run
+ * of consecutive positions at once. the capacity is a power of two and fixed
+ * by A##_init. items are copied in and out by value.
+ */
+
+/**********************************************************/
+/* DECLARATION ********************************************/
+/**********************************************************/
+
+/*
+ * N = name - the name of the queue struct
+ * A = abbreviation - the prefix of the functions
+ * T = type - the type of the items
+ */
+
+#define VEC_MPMC_INCLUDE(N, A, T) \
+    typedef struct N##Slot { \
+        atomic_size_t seq; \
+        T val; \
+    } N##Slot; \
+    \
+    typedef struct N { \
+        _Alignas(VEC_CACHE_LINE) atomic_size_t enqueue; \
+        _Alignas(VEC_CACHE_LINE) atomic_size_t dequeue; \
+        /* shared, read only */ \
+        _Alignas(VEC_CACHE_LINE) size_t cap; \
+        N##Slot *slots; \
+    } N; \
+    \
+    int A##_init(N *queue, size_t cap); \
+    void A##_free(N *queue); \
+    size_t A##_capacity(const N *queue); \
+    int A##_try_push(N *queue, T val); \
+    int A##_try_pop(N *queue, T *val); \
+    size_t A##_push_n(N *queue, const T *vals, size_t n); \
+    size_t A##_pop_n(N *queue, T *vals, size_t n); \
+
+/**********************************************************/
+/* IMPLEMENTATION *****************************************/
+/**********************************************************/
+
+#define VEC_MPMC_IMPLEMENT(N, A, T) \
+    /* public */ \
+    VEC_MPMC_IMPLEMENT_INIT(N, A, T);               \
+    VEC_MPMC_IMPLEMENT_FREE(N, A, T);               \
+    VEC_MPMC_IMPLEMENT_CAPACITY(N, A, T);           \
+    VEC_MPMC_IMPLEMENT_PUSH_N(N, A, T);             \
+    VEC_MPMC_IMPLEMENT_POP_N(N, A, T);              \
+    VEC_MPMC_IMPLEMENT_TRY_PUSH(N, A, T);           \
+    VEC_MPMC_IMPLEMENT_TRY_POP(N, A, T);            \
+
+/**********************************************************/
+/* PUBLIC FUNCTION IMPLEMENTATIONS ************************/
+/**********************************************************/
+
+/**
+ * @brief A##_init - set up an empty queue, before any thread uses it
+ * @param queue - the queue
+ * @param cap - minimum number of items it can hold (rounded up to a power of two, at least 2)
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_MPMC_IMPLEMENT_INIT(N, A, T) \
+    inline int A##_init(N *queue, size_t cap) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        size_t required = 2; \
+        while(required < cap) required *= 2; \
+        queue->slots = vec_malloc(sizeof(N##Slot) * required); \
+        if(!queue->slots) return VEC_ERROR_MALLOC; \
+        for(size_t i = 0; i < required; i++) { \
+            atomic_init(&queue->slots[i].seq, i); \
+        } \
+        queue->cap = required; \
+        atomic_init(&queue->enqueue, 0); \
+        atomic_init(&queue->dequeue, 0); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_free - free the queue, once no thread uses it anymore
+ * @param queue - the queue
+ * @return void
+ */
+#define VEC_MPMC_IMPLEMENT_FREE(N, A, T) \
+    inline void A##_free(N *queue) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        vec_free(queue->slots); \
+        queue->slots = 0; \
+        queue->cap = 0; \
+    }
+
+/**
+ * @brief A##_capacity - get the number of items the queue can hold
+ * @param queue - the queue
+ * @return capacity in items
+ */
+#define VEC_MPMC_IMPLEMENT_CAPACITY(N, A, T) \
+    inline size_t A##_capacity(const N *queue) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        return queue->cap; \
+    }
+
+/**
+ * @brief A##_push_n - enqueue as many items of a span as there are free slots in a row (any thread)
+ * @param queue - the queue
+ * @param vals - the items
+ * @param n - number of items
+ * @return number of items enqueued, zero if the queue is full
+ */
+#define VEC_MPMC_IMPLEMENT_PUSH_N(N, A, T) \
+    inline size_t A##_push_n(N *queue, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        VEC_ASSERT_REAL(vals || !n); \
+        size_t mask = queue->cap - 1; \
+        size_t pos = atomic_load_explicit(&queue->enqueue, memory_order_relaxed); \
+        size_t k = 0; \
+        while(n) { \
+            /* count the free slots in a row, starting at our position */ \
+            for(k = 0; k < n; k++) { \
+                size_t seq = atomic_load_explicit(&queue->slots[(pos + k) & mask].seq, memory_order_acquire); \
+                if(seq != pos + k) break; \
+            } \
+            if(k) { \
+                if(atomic_compare_exchange_weak_explicit(&queue->enqueue, &pos, pos + k, memory_order_relaxed, memory_order_relaxed)) break; \
+                /* pos got updated, try again */ \
+            } else { \
+                size_t seq = atomic_load_explicit(&queue->slots[pos & mask].seq, memory_order_acquire); \
+                if((intptr_t)(seq - pos) < 0) return 0; /* full */ \
+                pos = atomic_load_explicit(&queue->enqueue, memory_order_relaxed); \
+            } \
+        } \
+        for(size_t i = 0; i < k; i++) { \
+            N##Slot *slot = &queue->slots[(pos + i) & mask]; \
+            vec_memcpy(&slot->val, &vals[i], sizeof(T)); \
+            atomic_store_explicit(&slot->seq, pos + i + 1, memory_order_release); \
+        } \
+        return k; \
+    }
+
+/**
+ * @brief A##_pop_n - dequeue up to n items that are ready in a row into a span (any thread)
+ * @param queue - the queue
+ * @param vals - where to copy the items to
+ * @param n - maximum number of items
+ * @return number of items dequeued, zero if the queue is empty
+ */
+#define VEC_MPMC_IMPLEMENT_POP_N(N, A, T) \
+    inline size_t A##_pop_n(N *queue, T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        VEC_ASSERT_REAL(vals || !n); \
+        size_t mask = queue->cap - 1; \
+        size_t pos = atomic_load_explicit(&queue->dequeue, memory_order_relaxed); \
+        size_t k = 0; \
+        while(n) { \
+            /* count the filled slots in a row, starting at our position */ \
+            for(k = 0; k < n; k++) { \
+                size_t seq = atomic_load_explicit(&queue->slots[(pos + k) & mask].seq, memory_order_acquire); \
+                if(seq != pos + k + 1) break; \
+            } \
+            if(k) { \
+                if(atomic_compare_exchange_weak_explicit(&queue->dequeue, &pos, pos + k, memory_order_relaxed, memory_order_relaxed)) break; \
+                /* pos got updated, try again */ \
+            } else { \
+                size_t seq = atomic_load_explicit(&queue->slots[pos & mask].seq, memory_order_acquire); \
+                if((intptr_t)(seq - (pos + 1)) < 0) return 0; /* empty */ \
+                pos = atomic_load_explicit(&queue->dequeue, memory_order_relaxed); \
+            } \
+        } \
+        for(size_t i = 0; i < k; i++) { \
+            N##Slot *slot = &queue->slots[(pos + i) & mask]; \
+            vec_memcpy(&vals[i], &slot->val, sizeof(T)); \
+            atomic_store_explicit(&slot->seq, pos + i + mask + 1, memory_order_release); \
+        } \
+        return k; \
+    }
+
+/**
+ * @brief A##_try_push - enqueue one item (any thread)
+ * @param queue - the queue
+ * @param val - the item
+ * @return boolean: true if enqueued, false if the queue is full
+ */
+#define VEC_MPMC_IMPLEMENT_TRY_PUSH(N, A, T) \
+    inline int A##_try_push(N *queue, T val) \
+    { \
+        return A##_push_n(queue, &val, 1) == 1; \
+    }
+
+/**
+ * @brief A##_try_pop - dequeue one item (any thread)
+ * @param queue - the queue
+ * @param val - write back for the item, pass 0 to ignore
+ * @return boolean: true if dequeued, false if the queue is empty
+ */
+#define VEC_MPMC_IMPLEMENT_TRY_POP(N, A, T) \
+    inline int A##_try_pop(N *queue, T *val) \
+    { \
+        T temp; \
+        if(!A##_pop_n(queue, &temp, 1)) return 0; \
+        if(val) *val = temp; \
+        return 1; \
+    }
+
+#define VEC_MPMC_H
+#endif
+
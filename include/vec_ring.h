@@ -0,0 +1,378 @@
+/* MIT License
+
+Copyright (c) 2023 rphii
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef VEC_RING_H
+
+#include "vec.h"
+
+/*
+ * === THE RING DESCRIPTION ===
+ * a circular vector: items live at (head + index) & (cap - 1), so pushing
+ * and popping at both ends is O(1) and never shifts any items. the capacity
+ * is always a power of two. like the vector, popped slots stay owned by the
+ * ring (F is called on them once they get overwritten or the ring is freed)
+ */
+
+/* smallest power of two of at least n */
+static inline size_t vec_ring_pow2(size_t n)
+{
+    size_t cap = 1;
+    while(cap < n) cap *= 2;
+    return cap;
+}
+
+/**********************************************************/
+/* DECLARATION ********************************************/
+/**********************************************************/
+
+/*
+ * N = name - the name of the ring struct
+ * A = abbreviation - the prefix of the functions
+ * T = type - the type of the items
+ * F = free - function to use if your structure itself has a custom free routine
+ */
+
+#define VEC_RING_INCLUDE(N, A, T) \
+    typedef struct N { \
+        size_t cap; \
+        size_t head; \
+        size_t len; \
+        T *items; \
+    } N; \
+    \
+    void A##_clear(N *vec); \
+    size_t A##_length(const N *vec); \
+    size_t A##_capacity(const N *vec); \
+    int A##_empty(const N *vec); \
+    int A##_reserve(N *vec, size_t cap); \
+    int A##_push_front(N *vec, T val); \
+    int A##_push_back(N *vec, T val); \
+    void A##_pop_front(N *vec, T *val); \
+    void A##_pop_back(N *vec, T *val); \
+    T A##_get_front(const N *vec); \
+    T A##_get_back(const N *vec); \
+    T A##_get_at(const N *vec, size_t index); \
+    T *A##_iter_at(const N *vec, size_t index); \
+    void A##_segments(const N *vec, T **seg1, size_t *len1, T **seg2, size_t *len2); \
+    void A##_free(N *vec); \
+    void A##_zero(N *vec); \
+
+/**********************************************************/
+/* IMPLEMENTATION *****************************************/
+/**********************************************************/
+
+#define VEC_RING_IMPLEMENT(N, A, T, F) \
+    /* private */ \
+    VEC_RING_IMPLEMENT_STATIC_SLOT(N, A, T, F);     \
+    /* public */ \
+    VEC_RING_IMPLEMENT_CLEAR(N, A, T, F);           \
+    VEC_RING_IMPLEMENT_LENGTH(N, A, T, F);          \
+    VEC_RING_IMPLEMENT_CAPACITY(N, A, T, F);        \
+    VEC_RING_IMPLEMENT_EMPTY(N, A, T, F);           \
+    VEC_RING_IMPLEMENT_SEGMENTS(N, A, T, F);        \
+    VEC_RING_IMPLEMENT_RESERVE(N, A, T, F);         \
+    VEC_RING_IMPLEMENT_PUSH_FRONT(N, A, T, F);      \
+    VEC_RING_IMPLEMENT_PUSH_BACK(N, A, T, F);       \
+    VEC_RING_IMPLEMENT_POP_FRONT(N, A, T, F);       \
+    VEC_RING_IMPLEMENT_POP_BACK(N, A, T, F);        \
+    VEC_RING_IMPLEMENT_ITER_AT(N, A, T, F);         \
+    VEC_RING_IMPLEMENT_GET_AT(N, A, T, F);          \
+    VEC_RING_IMPLEMENT_GET_FRONT(N, A, T, F);       \
+    VEC_RING_IMPLEMENT_GET_BACK(N, A, T, F);        \
+    VEC_RING_IMPLEMENT_FREE(N, A, T, F);            \
+    VEC_RING_IMPLEMENT_ZERO(N, A, T, F);            \
+
+/**********************************************************/
+/* PRIVATE FUNCTION IMPLEMENTATIONS ***********************/
+/**********************************************************/
+
+/**
+ * @brief A##_static_slot - internal use, get the slot of an index, which may lie past the length
+ * @param vec - the ring
+ * @param index - the index, counted from the front
+ * @return pointer to the slot
+ */
+#define VEC_RING_IMPLEMENT_STATIC_SLOT(N, A, T, F) \
+    static inline T *A##_static_slot(const N *vec, size_t index) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(index < vec->cap); \
+        return &vec->items[(vec->head + index) & (vec->cap - 1)]; \
+    }
+
+/**********************************************************/
+/* PUBLIC FUNCTION IMPLEMENTATIONS ************************/
+/**********************************************************/
+
+/**
+ * @brief A##_clear - set the ring length to zero, but keep it's allocated memory
+ * @param vec - the ring
+ * @return void
+ */
+#define VEC_RING_IMPLEMENT_CLEAR(N, A, T, F) \
+    inline void A##_clear(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        vec->head = 0; \
+        vec->len = 0; \
+    }
+
+/**
+ * @brief A##_length - get the ring length (in items)
+ * @param vec - the ring
+ * @return length in items
+ */
+#define VEC_RING_IMPLEMENT_LENGTH(N, A, T, F) \
+    inline size_t A##_length(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return vec->len; \
+    }
+
+/**
+ * @brief A##_capacity - get number of allocated item spaces (not in bytes)
+ * @param vec - the ring
+ * @return capacity in item spaces
+ */
+#define VEC_RING_IMPLEMENT_CAPACITY(N, A, T, F) \
+    inline size_t A##_capacity(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return vec->cap; \
+    }
+
+/**
+ * @brief A##_empty - check if ring is empty
+ * @param vec - the ring
+ * @return boolean comparison: true if empty, false if not empty
+ */
+#define VEC_RING_IMPLEMENT_EMPTY(N, A, T, F) \
+    inline int A##_empty(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return !vec->len; \
+    }
+
+/**
+ * @brief A##_segments - get the items as two contiguous segments, the second one continuing the first
+ * @param vec - the ring
+ * @param seg1 - write back for the items from the front up to the end of memory
+ * @param len1 - write back for the number of items in seg1
+ * @param seg2 - write back for the wrapped around items, at the start of memory
+ * @param len2 - write back for the number of items in seg2 (zero if not wrapped around)
+ * @return void
+ */
+#define VEC_RING_IMPLEMENT_SEGMENTS(N, A, T, F) \
+    inline void A##_segments(const N *vec, T **seg1, size_t *len1, T **seg2, size_t *len2) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(seg1 && len1 && seg2 && len2); \
+        size_t until_end = vec->cap - vec->head; \
+        *len1 = vec->len < until_end ? vec->len : until_end; \
+        *len2 = vec->len - *len1; \
+        *seg1 = vec->items ? &vec->items[vec->head] : 0; \
+        *seg2 = vec->items; \
+    }
+
+/**
+ * @brief A##_reserve - reserve memory for a certain minimum number of items (only expanding), unwrapping the items
+ * @param vec - the ring
+ * @param cap - the minimum desired item capacity
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_RING_IMPLEMENT_RESERVE(N, A, T, F) \
+    inline int A##_reserve(N *vec, size_t cap) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        if(cap <= vec->cap) return VEC_ERROR_NONE; \
+        size_t required = vec_ring_pow2(cap < VEC_DEFAULT_SIZE ? VEC_DEFAULT_SIZE : cap); \
+        T *temp = vec_calloc(required, sizeof(T)); \
+        if(!temp) return VEC_ERROR_MALLOC; \
+        /* copy the items only once, front first, so that they don't wrap around anymore */ \
+        T *seg1 = 0, *seg2 = 0; \
+        size_t len1 = 0, len2 = 0; \
+        A##_segments(vec, &seg1, &len1, &seg2, &len2); \
+        if(len1) vec_memcpy(temp, seg1, sizeof(T) * len1); \
+        if(len2) vec_memcpy(temp + len1, seg2, sizeof(T) * len2); \
+        if(F != 0) { \
+            for(size_t i = vec->len; i < vec->cap; i++) { \
+                VEC_TYPE_FREE(F, A##_static_slot(vec, i), T); \
+            } \
+        } \
+        vec_free(vec->items); \
+        vec->items = temp; \
+        vec->head = 0; \
+        vec->cap = required; \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_push_front - push one item to the front
+ * @param vec - the ring
+ * @param val - the value to be pushed
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_RING_IMPLEMENT_PUSH_FRONT(N, A, T, F) \
+    inline int A##_push_front(N *vec, T val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        int result = A##_reserve(vec, vec->len + 1); \
+        if(result) return result; \
+        vec->head = (vec->head - 1) & (vec->cap - 1); \
+        vec->len++; \
+        T *item = A##_static_slot(vec, 0); \
+        if(F != 0) VEC_TYPE_FREE(F, item, T); /* in case we popped (but didn't free) */ \
+        vec_memcpy(item, &val, sizeof(T)); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_push_back - push one item to the back
+ * @param vec - the ring
+ * @param val - the value to be pushed
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_RING_IMPLEMENT_PUSH_BACK(N, A, T, F) \
+    inline int A##_push_back(N *vec, T val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        int result = A##_reserve(vec, vec->len + 1); \
+        if(result) return result; \
+        T *item = A##_static_slot(vec, vec->len++); \
+        if(F != 0) VEC_TYPE_FREE(F, item, T); /* in case we popped (but didn't free) */ \
+        vec_memcpy(item, &val, sizeof(T)); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_pop_front - pop one item from the front
+ * @param vec - the ring
+ * @param val - write back for popped value, pass 0 to ignore
+ * @return void
+ */
+#define VEC_RING_IMPLEMENT_POP_FRONT(N, A, T, F) \
+    inline void A##_pop_front(N *vec, T *val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(vec->len); \
+        if(val) vec_memcpy(val, A##_static_slot(vec, 0), sizeof(T)); \
+        vec->head = (vec->head + 1) & (vec->cap - 1); \
+        vec->len--; \
+    }
+
+/**
+ * @brief A##_pop_back - pop one item from the back
+ * @param vec - the ring
+ * @param val - write back for popped value, pass 0 to ignore
+ * @return void
+ */
+#define VEC_RING_IMPLEMENT_POP_BACK(N, A, T, F) \
+    inline void A##_pop_back(N *vec, T *val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(vec->len); \
+        vec->len--; \
+        if(val) vec_memcpy(val, A##_static_slot(vec, vec->len), sizeof(T)); \
+    }
+
+/**
+ * @brief A##_iter_at - get pointer to item at index
+ * @param vec - the ring
+ * @param index - the index, counted from the front
+ * @return pointer to item
+ */
+#define VEC_RING_IMPLEMENT_ITER_AT(N, A, T, F) \
+    inline T *A##_iter_at(const N *vec, size_t index) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(index < vec->len); \
+        return A##_static_slot(vec, index); \
+    }
+
+/**
+ * @brief A##_get_at - get item at index
+ * @param vec - the ring
+ * @param index - the index, counted from the front
+ * @return item
+ */
+#define VEC_RING_IMPLEMENT_GET_AT(N, A, T, F) \
+    inline T A##_get_at(const N *vec, size_t index) \
+    { \
+        return *A##_iter_at(vec, index); \
+    }
+
+/**
+ * @brief A##_get_front - get first item
+ * @param vec - the ring
+ * @return item
+ */
+#define VEC_RING_IMPLEMENT_GET_FRONT(N, A, T, F) \
+    inline T A##_get_front(const N *vec) \
+    { \
+        return *A##_iter_at(vec, 0); \
+    }
+
+/**
+ * @brief A##_get_back - get last item
+ * @param vec - the ring
+ * @return item
+ */
+#define VEC_RING_IMPLEMENT_GET_BACK(N, A, T, F) \
+    inline T A##_get_back(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return *A##_iter_at(vec, vec->len - 1); \
+    }
+
+/**
+ * @brief A##_free - free the ring and all of its slots
+ * @param vec - the ring
+ * @return void
+ */
+#define VEC_RING_IMPLEMENT_FREE(N, A, T, F) \
+    inline void A##_free(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        if(F != 0) { \
+            for(size_t i = 0; i < vec->cap; i++) { \
+                VEC_TYPE_FREE(F, &vec->items[i], T); \
+            } \
+        } \
+        vec_free(vec->items); \
+        A##_zero(vec); \
+    }
+
+/**
+ * @brief A##_zero - set the ring struct without freeing to zero
+ * @param vec - the ring
+ * @return void
+ */
+#define VEC_RING_IMPLEMENT_ZERO(N, A, T, F) \
+    inline void A##_zero(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        vec_memset(vec, 0, sizeof(*vec)); \
+    }
+
+#define VEC_RING_H
+#endif
+
@@ -0,0 +1,584 @@
+/* MIT License
+
+Copyright (c) 2023 rphii
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "vec.h"
+
+/* settings, re-evaluated on every include (see vec.h) */
+
+#undef  VEC_ROPE_LEAF
+#ifdef  VEC_SETTINGS_ROPE_LEAF
+#define VEC_ROPE_LEAF VEC_SETTINGS_ROPE_LEAF
+#else
+#define VEC_ROPE_LEAF 4096
+#endif
+
+#ifndef VEC_ROPE_H
+
+/*
+ * === THE ROPE DESCRIPTION ===
+ * an implicit treap of leaves: every node owns one BY_VAL vector V (prefix
+ * VA) and knows how many items are in its subtree, so finding an index,
+ * splitting and concatenating only walk one path, O(log n) expected. nodes
+ * are ordered by position and heap ordered by a random priority, which keeps
+ * the tree balanced. appending never touches existing leaves, except for
+ * filling up the last one while it's shorter than VEC_SETTINGS_ROPE_LEAF
+ * items, so content is never copied twice. splitting inside a leaf copies
+ * the part behind the split into a new leaf. the settings of V
+ * (VEC_SETTINGS_DEFAULT_SIZE, VEC_SETTINGS_KEEP_ZERO_END, ...) have to be set
+ * when including and implementing, leaves are zero terminated like V. meant
+ * for vectors without a free function, like Str.
+ */
+
+/**********************************************************/
+/* DECLARATION ********************************************/
+/**********************************************************/
+
+/*
+ * N = name - the name of the rope struct
+ * A = abbreviation - the prefix of the functions
+ * T = type - the type of the items
+ * V = vector - the name of the BY_VAL vector struct used for the leaves
+ * VA = vector abbreviation - the prefix of the vector functions
+ */
+
+#define VEC_ROPE_INCLUDE(N, A, T, V) \
+    typedef struct N##Node { \
+        struct N##Node *left; \
+        struct N##Node *right; \
+        size_t size; \
+        size_t priority; \
+        V leaf; \
+    } N##Node; \
+    \
+    typedef struct N { \
+        N##Node *root; \
+        size_t seed; \
+    } N; \
+    \
+    size_t A##_length(const N *rope); \
+    int A##_empty(const N *rope); \
+    int A##_append(N *rope, V *leaf); \
+    int A##_append_n(N *rope, const T *vals, size_t n); \
+    void A##_concat(N *rope, N *other); \
+    int A##_split(N *rope, size_t index, N *right); \
+    int A##_insert_at(N *rope, size_t index, const T *vals, size_t n); \
+    int A##_erase_at(N *rope, size_t index, size_t n); \
+    T A##_get_at(const N *rope, size_t index); \
+    T *A##_iter_at(const N *rope, size_t index); \
+    int A##_flatten(const N *rope, V *vec); \
+    void A##_free(N *rope); \
+    void A##_zero(N *rope); \
+
+/**********************************************************/
+/* IMPLEMENTATION *****************************************/
+/**********************************************************/
+
+#define VEC_ROPE_IMPLEMENT(N, A, T, V, VA) \
+    /* private */ \
+    VEC_ROPE_IMPLEMENT_STATIC_SIZE(N, A, T, V, VA);         \
+    VEC_ROPE_IMPLEMENT_STATIC_UPDATE(N, A, T, V, VA);       \
+    VEC_ROPE_IMPLEMENT_STATIC_PRIORITY(N, A, T, V, VA);     \
+    VEC_ROPE_IMPLEMENT_STATIC_LEAF_APPEND(N, A, T, V, VA);  \
+    VEC_ROPE_IMPLEMENT_STATIC_NODE(N, A, T, V, VA);         \
+    VEC_ROPE_IMPLEMENT_STATIC_MERGE(N, A, T, V, VA);        \
+    VEC_ROPE_IMPLEMENT_STATIC_SPLIT(N, A, T, V, VA);        \
+    VEC_ROPE_IMPLEMENT_STATIC_BUILD(N, A, T, V, VA);        \
+    VEC_ROPE_IMPLEMENT_STATIC_FLATTEN(N, A, T, V, VA);      \
+    VEC_ROPE_IMPLEMENT_STATIC_FREE(N, A, T, V, VA);         \
+    /* public */ \
+    VEC_ROPE_IMPLEMENT_LENGTH(N, A, T, V, VA);              \
+    VEC_ROPE_IMPLEMENT_EMPTY(N, A, T, V, VA);               \
+    VEC_ROPE_IMPLEMENT_APPEND(N, A, T, V, VA);              \
+    VEC_ROPE_IMPLEMENT_APPEND_N(N, A, T, V, VA);            \
+    VEC_ROPE_IMPLEMENT_CONCAT(N, A, T, V, VA);              \
+    VEC_ROPE_IMPLEMENT_SPLIT(N, A, T, V, VA);               \
+    VEC_ROPE_IMPLEMENT_INSERT_AT(N, A, T, V, VA);           \
+    VEC_ROPE_IMPLEMENT_ERASE_AT(N, A, T, V, VA);            \
+    VEC_ROPE_IMPLEMENT_ITER_AT(N, A, T, V, VA);             \
+    VEC_ROPE_IMPLEMENT_GET_AT(N, A, T, V, VA);              \
+    VEC_ROPE_IMPLEMENT_FLATTEN(N, A, T, V, VA);             \
+    VEC_ROPE_IMPLEMENT_FREE(N, A, T, V, VA);                \
+    VEC_ROPE_IMPLEMENT_ZERO(N, A, T, V, VA);                \
+
+/**********************************************************/
+/* PRIVATE FUNCTION IMPLEMENTATIONS ***********************/
+/**********************************************************/
+
+/**
+ * @brief A##_static_size - internal use, get the number of items in a subtree
+ * @param node - the subtree, may be 0
+ * @return number of items
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_SIZE(N, A, T, V, VA) \
+    static inline size_t A##_static_size(const N##Node *node) \
+    { \
+        return node ? node->size : 0; \
+    }
+
+/**
+ * @brief A##_static_update - internal use, recount the items of a node after its children or leaf changed
+ * @param node - the node
+ * @return void
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_UPDATE(N, A, T, V, VA) \
+    static inline void A##_static_update(N##Node *node) \
+    { \
+        node->size = A##_static_size(node->left) + VA##_length(&node->leaf) + A##_static_size(node->right); \
+    }
+
+/**
+ * @brief A##_static_priority - internal use, get the next random priority (xorshift)
+ * @param rope - the rope
+ * @return random number
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_PRIORITY(N, A, T, V, VA) \
+    static inline size_t A##_static_priority(N *rope) \
+    { \
+        size_t x = rope->seed ? rope->seed : (size_t)0x2545F4914F6CDD1DULL; \
+        x ^= x << 13; \
+        x ^= x >> 7; \
+        x ^= x << 17; \
+        rope->seed = x; \
+        return x; \
+    }
+
+/**
+ * @brief A##_static_leaf_append - internal use, copy items to the back of a leaf, keeping its zero end
+ * @param leaf - the leaf
+ * @param vals - the items
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_LEAF_APPEND(N, A, T, V, VA) \
+    static inline int A##_static_leaf_append(V *leaf, const T *vals, size_t n) \
+    { \
+        int result = VA##_reserve(leaf, leaf->last + n); \
+        if(result) return result; \
+        if(n) vec_memcpy(VA##_iter_end(leaf), vals, sizeof(T) * n); \
+        leaf->last += n; \
+        if(VEC_KEEP_ZERO_END) vec_memset(VA##_iter_end(leaf), 0, sizeof(T) * VEC_KEEP_ZERO_END); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_static_node - internal use, make a node that takes over a leaf
+ * @param rope - the rope
+ * @param leaf - the leaf, empty once taken over
+ * @return the node, 0 if failure
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_NODE(N, A, T, V, VA) \
+    static inline N##Node *A##_static_node(N *rope, V *leaf) \
+    { \
+        N##Node *node = vec_malloc(sizeof(*node)); \
+        if(!node) return 0; \
+        node->left = 0; \
+        node->right = 0; \
+        node->priority = A##_static_priority(rope); \
+        /* moved, so inline items end up in the node */ \
+        node->leaf = (V){0}; \
+        VA##_move(&node->leaf, leaf); \
+        A##_static_update(node); \
+        return node; \
+    }
+
+/**
+ * @brief A##_static_merge - internal use, join two subtrees, all items of a in front of the ones of b
+ * @param a - the front subtree, may be 0
+ * @param b - the back subtree, may be 0
+ * @return the joined subtree
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_MERGE(N, A, T, V, VA) \
+    static N##Node *A##_static_merge(N##Node *a, N##Node *b) \
+    { \
+        if(!a) return b; \
+        if(!b) return a; \
+        if(a->priority > b->priority) { \
+            a->right = A##_static_merge(a->right, b); \
+            A##_static_update(a); \
+            return a; \
+        } \
+        b->left = A##_static_merge(a, b->left); \
+        A##_static_update(b); \
+        return b; \
+    }
+
+/**
+ * @brief A##_static_split - internal use, split a subtree into the first index items and the rest
+ * @param rope - the rope (for priorities of split leaves)
+ * @param node - the subtree, may be 0
+ * @param index - the number of items going to the front
+ * @param front - write back for the front subtree
+ * @param back - write back for the back subtree
+ * @return zero if success, non-zero if failure (all items are kept in order, but possibly split elsewhere)
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_SPLIT(N, A, T, V, VA) \
+    static int A##_static_split(N *rope, N##Node *node, size_t index, N##Node **front, N##Node **back) \
+    { \
+        int result = VEC_ERROR_NONE; \
+        if(!node) { \
+            *front = *back = 0; \
+            return result; \
+        } \
+        size_t left = A##_static_size(node->left); \
+        size_t len = VA##_length(&node->leaf); \
+        if(index <= left) { \
+            result = A##_static_split(rope, node->left, index, front, &node->left); \
+            A##_static_update(node); \
+            *back = node; \
+        } else if(index >= left + len) { \
+            result = A##_static_split(rope, node->right, index - left - len, &node->right, back); \
+            A##_static_update(node); \
+            *front = node; \
+        } else { \
+            /* the split is inside this leaf, copy its back part into a new one */ \
+            size_t offset = index - left; \
+            V tail = {0}; \
+            result = A##_static_leaf_append(&tail, VA##_iter_at(&node->leaf, offset), len - offset); \
+            N##Node *split = result ? 0 : A##_static_node(rope, &tail); \
+            if(!split) { \
+                VA##_free(&tail); \
+                *front = node; \
+                *back = 0; \
+                return result ? result : VEC_ERROR_MALLOC; \
+            } \
+            node->leaf.last = node->leaf.first + offset; \
+            if(VEC_KEEP_ZERO_END) vec_memset(VA##_iter_end(&node->leaf), 0, sizeof(T) * VEC_KEEP_ZERO_END); \
+            N##Node *right = node->right; \
+            node->right = 0; \
+            A##_static_update(node); \
+            *front = node; \
+            *back = A##_static_merge(split, right); \
+        } \
+        return result; \
+    }
+
+/**
+ * @brief A##_static_build - internal use, make a subtree of items, in leaves of at most VEC_ROPE_LEAF items
+ * @param rope - the rope (for priorities)
+ * @param vals - the items
+ * @param n - number of items
+ * @param node - write back for the subtree
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_BUILD(N, A, T, V, VA) \
+    static int A##_static_build(N *rope, const T *vals, size_t n, N##Node **node) \
+    { \
+        *node = 0; \
+        for(size_t i = 0; i < n; i += VEC_ROPE_LEAF) { \
+            size_t len = n - i < VEC_ROPE_LEAF ? n - i : VEC_ROPE_LEAF; \
+            V leaf = {0}; \
+            int result = A##_static_leaf_append(&leaf, vals + i, len); \
+            N##Node *next = result ? 0 : A##_static_node(rope, &leaf); \
+            if(!next) { \
+                VA##_free(&leaf); \
+                return result ? result : VEC_ERROR_MALLOC; \
+            } \
+            *node = A##_static_merge(*node, next); \
+        } \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_static_flatten - internal use, copy the items of a subtree in order
+ * @param node - the subtree, may be 0
+ * @param items - where to copy the items to
+ * @return number of items copied
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_FLATTEN(N, A, T, V, VA) \
+    static size_t A##_static_flatten(const N##Node *node, T *items) \
+    { \
+        size_t done = 0; \
+        while(node) { \
+            done += A##_static_flatten(node->left, items + done); \
+            size_t len = VA##_length(&node->leaf); \
+            if(len) vec_memcpy(items + done, VA##_iter_begin(&node->leaf), sizeof(T) * len); \
+            done += len; \
+            node = node->right; \
+        } \
+        return done; \
+    }
+
+/**
+ * @brief A##_static_free - internal use, free a subtree and its leaves
+ * @param node - the subtree, may be 0
+ * @return void
+ */
+#define VEC_ROPE_IMPLEMENT_STATIC_FREE(N, A, T, V, VA) \
+    static void A##_static_free(N##Node *node) \
+    { \
+        while(node) { \
+            N##Node *right = node->right; \
+            A##_static_free(node->left); \
+            VA##_free(&node->leaf); \
+            vec_free(node); \
+            node = right; \
+        } \
+    }
+
+/**********************************************************/
+/* PUBLIC FUNCTION IMPLEMENTATIONS ************************/
+/**********************************************************/
+
+/**
+ * @brief A##_length - get the length (in items)
+ * @param rope - the rope
+ * @return length in items
+ */
+#define VEC_ROPE_IMPLEMENT_LENGTH(N, A, T, V, VA) \
+    inline size_t A##_length(const N *rope) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        return A##_static_size(rope->root); \
+    }
+
+/**
+ * @brief A##_empty - check if empty
+ * @param rope - the rope
+ * @return boolean comparison: true if empty, false if not empty
+ */
+#define VEC_ROPE_IMPLEMENT_EMPTY(N, A, T, V, VA) \
+    inline int A##_empty(const N *rope) \
+    { \
+        return !A##_length(rope); \
+    }
+
+/**
+ * @brief A##_append - append a vector as a new leaf, without copying its items
+ * @param rope - the rope
+ * @param leaf - the vector, empty once taken over (its items may be inline, see VEC_SETTINGS_INLINE_CAP)
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_APPEND(N, A, T, V, VA) \
+    inline int A##_append(N *rope, V *leaf) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(leaf); \
+        N##Node *node = A##_static_node(rope, leaf); \
+        if(!node) return VEC_ERROR_MALLOC; \
+        rope->root = A##_static_merge(rope->root, node); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_append_n - append items, filling up the last leaf first
+ * @param rope - the rope
+ * @param vals - the items
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_APPEND_N(N, A, T, V, VA) \
+    inline int A##_append_n(N *rope, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(vals || !n); \
+        N##Node *last = rope->root; \
+        while(last && last->right) last = last->right; \
+        size_t len = last ? VA##_length(&last->leaf) : 0; \
+        if(last && len < VEC_ROPE_LEAF && n) { \
+            size_t fill = VEC_ROPE_LEAF - len < n ? VEC_ROPE_LEAF - len : n; \
+            int result = A##_static_leaf_append(&last->leaf, vals, fill); \
+            if(result) return result; \
+            /* the right spine holds the last leaf */ \
+            for(N##Node *node = rope->root; node; node = node->right) node->size += fill; \
+            vals += fill; \
+            n -= fill; \
+        } \
+        if(!n) return VEC_ERROR_NONE; \
+        N##Node *node = 0; \
+        int result = A##_static_build(rope, vals, n, &node); \
+        rope->root = A##_static_merge(rope->root, node); \
+        return result; \
+    }
+
+/**
+ * @brief A##_concat - move all items of another rope to the back, without copying them
+ * @param rope - the rope
+ * @param other - the other rope, empty afterwards
+ * @return void
+ */
+#define VEC_ROPE_IMPLEMENT_CONCAT(N, A, T, V, VA) \
+    inline void A##_concat(N *rope, N *other) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(other); \
+        VEC_ASSERT_REAL(rope != other); \
+        rope->root = A##_static_merge(rope->root, other->root); \
+        other->root = 0; \
+    }
+
+/**
+ * @brief A##_split - move all items from an index on into another rope
+ * @param rope - the rope, keeping the first index items
+ * @param index - the index, up to the length
+ * @param right - the rope receiving the rest, has to be empty
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_SPLIT(N, A, T, V, VA) \
+    inline int A##_split(N *rope, size_t index, N *right) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(right); \
+        VEC_ASSERT_REAL(!right->root); \
+        VEC_ASSERT_REAL(index <= A##_length(rope)); \
+        N##Node *front = 0, *back = 0; \
+        int result = A##_static_split(rope, rope->root, index, &front, &back); \
+        rope->root = front; \
+        right->root = back; \
+        return result; \
+    }
+
+/**
+ * @brief A##_insert_at - insert items in front of an index
+ * @param rope - the rope
+ * @param index - the index, up to the length
+ * @param vals - the items
+ * @param n - number of items
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_INSERT_AT(N, A, T, V, VA) \
+    inline int A##_insert_at(N *rope, size_t index, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(vals || !n); \
+        VEC_ASSERT_REAL(index <= A##_length(rope)); \
+        N##Node *front = 0, *back = 0, *middle = 0; \
+        int result = A##_static_split(rope, rope->root, index, &front, &back); \
+        result |= result ?: A##_static_build(rope, vals, n, &middle); \
+        rope->root = A##_static_merge(A##_static_merge(front, middle), back); \
+        return result; \
+    }
+
+/**
+ * @brief A##_erase_at - erase items starting at an index
+ * @param rope - the rope
+ * @param index - the index
+ * @param n - number of items, up to the ones from index on
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_ERASE_AT(N, A, T, V, VA) \
+    inline int A##_erase_at(N *rope, size_t index, size_t n) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(index + n <= A##_length(rope)); \
+        N##Node *front = 0, *middle = 0, *back = 0; \
+        int result = A##_static_split(rope, rope->root, index, &front, &back); \
+        if(result) { \
+            rope->root = A##_static_merge(front, back); \
+            return result; \
+        } \
+        result = A##_static_split(rope, back, n, &middle, &back); \
+        if(result) { \
+            rope->root = A##_static_merge(A##_static_merge(front, middle), back); \
+            return result; \
+        } \
+        A##_static_free(middle); \
+        rope->root = A##_static_merge(front, back); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_iter_at - get pointer to item at index, valid until the rope gets modified
+ * @param rope - the rope
+ * @param index - the index
+ * @return pointer to item
+ */
+#define VEC_ROPE_IMPLEMENT_ITER_AT(N, A, T, V, VA) \
+    inline T *A##_iter_at(const N *rope, size_t index) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(index < A##_length(rope)); \
+        N##Node *node = rope->root; \
+        for(;;) { \
+            size_t left = A##_static_size(node->left); \
+            size_t len = VA##_length(&node->leaf); \
+            if(index < left) { \
+                node = node->left; \
+            } else if(index < left + len) { \
+                return VA##_iter_at(&node->leaf, index - left); \
+            } else { \
+                index -= left + len; \
+                node = node->right; \
+            } \
+        } \
+    }
+
+/**
+ * @brief A##_get_at - get item at index
+ * @param rope - the rope
+ * @param index - the index
+ * @return item
+ */
+#define VEC_ROPE_IMPLEMENT_GET_AT(N, A, T, V, VA) \
+    inline T A##_get_at(const N *rope, size_t index) \
+    { \
+        return *A##_iter_at(rope, index); \
+    }
+
+/**
+ * @brief A##_flatten - copy all items into a vector, replacing its items (and keeping its zero end)
+ * @param rope - the rope
+ * @param vec - the vector, with no free function
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_ROPE_IMPLEMENT_FLATTEN(N, A, T, V, VA) \
+    inline int A##_flatten(const N *rope, V *vec) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        VEC_ASSERT_REAL(vec); \
+        size_t len = A##_length(rope); \
+        VA##_clear(vec); \
+        int result = VA##_reserve(vec, len); \
+        if(result) return result; \
+        A##_static_flatten(rope->root, VA##_iter_begin(vec)); \
+        vec->last = vec->first + len; \
+        if(VEC_KEEP_ZERO_END) vec_memset(VA##_iter_end(vec), 0, sizeof(T) * VEC_KEEP_ZERO_END); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_free - free all nodes and leaves
+ * @param rope - the rope
+ * @return void
+ */
+#define VEC_ROPE_IMPLEMENT_FREE(N, A, T, V, VA) \
+    inline void A##_free(N *rope) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        A##_static_free(rope->root); \
+        A##_zero(rope); \
+    }
+
+/**
+ * @brief A##_zero - set the struct without freeing to zero
+ * @param rope - the rope
+ * @return void
+ */
+#define VEC_ROPE_IMPLEMENT_ZERO(N, A, T, V, VA) \
+    inline void A##_zero(N *rope) \
+    { \
+        VEC_ASSERT_REAL(rope); \
+        vec_memset(rope, 0, sizeof(*rope)); \
+    }
+
+#define VEC_ROPE_H
+#endif
+
@@ -0,0 +1,361 @@
+/* MIT License
+
+Copyright (c) 2023 rphii
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "vec.h"
+
+/* settings, re-evaluated on every include (see vec.h) */
+
+#undef  VEC_SEG_BASE
+#ifdef  VEC_SETTINGS_SEG_BASE
+#define VEC_SEG_BASE VEC_SETTINGS_SEG_BASE
+#else
+#define VEC_SEG_BASE 16
+#endif
+
+#ifndef VEC_SEG_H
+
+/*
+ * === THE SEGMENTED VECTOR DESCRIPTION ===
+ * items are stored in chunks that double in size: chunk k holds
+ * VEC_SEG_BASE << k items and starts at index VEC_SEG_BASE * (2^k - 1).
+ * growing only ever allocates the next chunk, so items never move and
+ * pointers to them stay valid until they're popped. the directory of chunks
+ * is a fixed array inside the struct, indexing is O(1). like the vector,
+ * popped slots stay owned by it (F is called on them once they get
+ * overwritten or the vector is freed)
+ */
+
+/* enough chunks to cover every index of a size_t */
+#define VEC_SEG_DIRECTORY   (sizeof(size_t) * 8)
+
+/* index of the highest bit set, x has to be non-zero */
+static inline size_t vec_seg_log2(size_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return sizeof(unsigned long long) * 8 - 1 - (size_t)__builtin_clzll((unsigned long long)x);
+#else
+    size_t result = 0;
+    while(x >>= 1) result++;
+    return result;
+#endif
+}
+
+/**********************************************************/
+/* DECLARATION ********************************************/
+/**********************************************************/
+
+/*
+ * N = name - the name of the segmented vector struct
+ * A = abbreviation - the prefix of the functions
+ * T = type - the type of the items
+ * F = free - function to use if your structure itself has a custom free routine
+ */
+
+#define VEC_SEG_INCLUDE(N, A, T) \
+    typedef struct N { \
+        size_t len; \
+        size_t chunks; \
+        T *directory[VEC_SEG_DIRECTORY]; \
+    } N; \
+    \
+    void A##_clear(N *vec); \
+    size_t A##_length(const N *vec); \
+    size_t A##_capacity(const N *vec); \
+    int A##_empty(const N *vec); \
+    int A##_reserve(N *vec, size_t cap); \
+    int A##_push_back(N *vec, T val); \
+    void A##_pop_back(N *vec, T *val); \
+    void A##_set_at(N *vec, size_t index, T val); \
+    T A##_get_at(const N *vec, size_t index); \
+    T *A##_iter_at(const N *vec, size_t index); \
+    size_t A##_chunks(const N *vec); \
+    size_t A##_chunk(const N *vec, size_t k, T **items); \
+    void A##_free(N *vec); \
+    void A##_zero(N *vec); \
+
+/**********************************************************/
+/* IMPLEMENTATION *****************************************/
+/**********************************************************/
+
+#define VEC_SEG_IMPLEMENT(N, A, T, F) \
+    /* private */ \
+    VEC_SEG_IMPLEMENT_STATIC_CHUNK_SIZE(N, A, T, F);    \
+    VEC_SEG_IMPLEMENT_STATIC_SLOT(N, A, T, F);          \
+    /* public */ \
+    VEC_SEG_IMPLEMENT_CLEAR(N, A, T, F);                \
+    VEC_SEG_IMPLEMENT_LENGTH(N, A, T, F);               \
+    VEC_SEG_IMPLEMENT_CAPACITY(N, A, T, F);             \
+    VEC_SEG_IMPLEMENT_EMPTY(N, A, T, F);                \
+    VEC_SEG_IMPLEMENT_RESERVE(N, A, T, F);              \
+    VEC_SEG_IMPLEMENT_PUSH_BACK(N, A, T, F);            \
+    VEC_SEG_IMPLEMENT_POP_BACK(N, A, T, F);             \
+    VEC_SEG_IMPLEMENT_ITER_AT(N, A, T, F);              \
+    VEC_SEG_IMPLEMENT_SET_AT(N, A, T, F);               \
+    VEC_SEG_IMPLEMENT_GET_AT(N, A, T, F);               \
+    VEC_SEG_IMPLEMENT_CHUNKS(N, A, T, F);               \
+    VEC_SEG_IMPLEMENT_CHUNK(N, A, T, F);                \
+    VEC_SEG_IMPLEMENT_FREE(N, A, T, F);                 \
+    VEC_SEG_IMPLEMENT_ZERO(N, A, T, F);                 \
+
+/**********************************************************/
+/* PRIVATE FUNCTION IMPLEMENTATIONS ***********************/
+/**********************************************************/
+
+/**
+ * @brief A##_static_chunk_size - internal use, number of items chunk k holds
+ * @param k - the chunk
+ * @return number of items
+ */
+#define VEC_SEG_IMPLEMENT_STATIC_CHUNK_SIZE(N, A, T, F) \
+    static inline size_t A##_static_chunk_size(size_t k) \
+    { \
+        return (size_t)VEC_SEG_BASE << k; \
+    }
+
+/**
+ * @brief A##_static_slot - internal use, get the slot of an index, which may lie past the length
+ * @param vec - the segmented vector
+ * @param index - the index, has to be below the capacity
+ * @return pointer to the slot
+ */
+#define VEC_SEG_IMPLEMENT_STATIC_SLOT(N, A, T, F) \
+    static inline T *A##_static_slot(const N *vec, size_t index) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        size_t k = vec_seg_log2(index / VEC_SEG_BASE + 1); \
+        size_t offset = index - ((size_t)VEC_SEG_BASE << k) + VEC_SEG_BASE; \
+        VEC_ASSERT_REAL(k < vec->chunks); \
+        return &vec->directory[k][offset]; \
+    }
+
+/**********************************************************/
+/* PUBLIC FUNCTION IMPLEMENTATIONS ************************/
+/**********************************************************/
+
+/**
+ * @brief A##_clear - set the length to zero, but keep the allocated chunks
+ * @param vec - the segmented vector
+ * @return void
+ */
+#define VEC_SEG_IMPLEMENT_CLEAR(N, A, T, F) \
+    inline void A##_clear(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        vec->len = 0; \
+    }
+
+/**
+ * @brief A##_length - get the length (in items)
+ * @param vec - the segmented vector
+ * @return length in items
+ */
+#define VEC_SEG_IMPLEMENT_LENGTH(N, A, T, F) \
+    inline size_t A##_length(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return vec->len; \
+    }
+
+/**
+ * @brief A##_capacity - get number of allocated item spaces (not in bytes)
+ * @param vec - the segmented vector
+ * @return capacity in item spaces
+ */
+#define VEC_SEG_IMPLEMENT_CAPACITY(N, A, T, F) \
+    inline size_t A##_capacity(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return VEC_SEG_BASE * (((size_t)1 << vec->chunks) - 1); \
+    }
+
+/**
+ * @brief A##_empty - check if empty
+ * @param vec - the segmented vector
+ * @return boolean comparison: true if empty, false if not empty
+ */
+#define VEC_SEG_IMPLEMENT_EMPTY(N, A, T, F) \
+    inline int A##_empty(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        return !vec->len; \
+    }
+
+/**
+ * @brief A##_reserve - allocate chunks until a certain number of items fits, never moving any items
+ * @param vec - the segmented vector
+ * @param cap - the minimum desired item capacity
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_SEG_IMPLEMENT_RESERVE(N, A, T, F) \
+    inline int A##_reserve(N *vec, size_t cap) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        while(A##_capacity(vec) < cap) { \
+            VEC_ASSERT_REAL(vec->chunks < VEC_SEG_DIRECTORY); \
+            T *chunk = vec_calloc(A##_static_chunk_size(vec->chunks), sizeof(T)); \
+            if(!chunk) return VEC_ERROR_MALLOC; \
+            vec->directory[vec->chunks++] = chunk; \
+        } \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_push_back - push one item to the back
+ * @param vec - the segmented vector
+ * @param val - the value to be pushed
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_SEG_IMPLEMENT_PUSH_BACK(N, A, T, F) \
+    inline int A##_push_back(N *vec, T val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        int result = A##_reserve(vec, vec->len + 1); \
+        if(result) return result; \
+        T *item = A##_static_slot(vec, vec->len++); \
+        if(F != 0) VEC_TYPE_FREE(F, item, T); /* in case we popped (but didn't free) */ \
+        vec_memcpy(item, &val, sizeof(T)); \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_pop_back - pop one item from the back
+ * @param vec - the segmented vector
+ * @param val - write back for popped value, pass 0 to ignore
+ * @return void
+ */
+#define VEC_SEG_IMPLEMENT_POP_BACK(N, A, T, F) \
+    inline void A##_pop_back(N *vec, T *val) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(vec->len); \
+        vec->len--; \
+        if(val) vec_memcpy(val, A##_static_slot(vec, vec->len), sizeof(T)); \
+    }
+
+/**
+ * @brief A##_iter_at - get pointer to item at index, which stays valid until the item is popped
+ * @param vec - the segmented vector
+ * @param index - the index
+ * @return pointer to item
+ */
+#define VEC_SEG_IMPLEMENT_ITER_AT(N, A, T, F) \
+    inline T *A##_iter_at(const N *vec, size_t index) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(index < vec->len); \
+        return A##_static_slot(vec, index); \
+    }
+
+/**
+ * @brief A##_set_at - overwrite item at index, freeing the previous one
+ * @param vec - the segmented vector
+ * @param index - the index
+ * @param val - the value
+ * @return void
+ */
+#define VEC_SEG_IMPLEMENT_SET_AT(N, A, T, F) \
+    inline void A##_set_at(N *vec, size_t index, T val) \
+    { \
+        T *item = A##_iter_at(vec, index); \
+        if(F != 0) VEC_TYPE_FREE(F, item, T); \
+        vec_memcpy(item, &val, sizeof(T)); \
+    }
+
+/**
+ * @brief A##_get_at - get item at index
+ * @param vec - the segmented vector
+ * @param index - the index
+ * @return item
+ */
+#define VEC_SEG_IMPLEMENT_GET_AT(N, A, T, F) \
+    inline T A##_get_at(const N *vec, size_t index) \
+    { \
+        return *A##_iter_at(vec, index); \
+    }
+
+/**
+ * @brief A##_chunks - get the number of chunks holding items, for chunk-wise iteration
+ * @param vec - the segmented vector
+ * @return number of chunks
+ */
+#define VEC_SEG_IMPLEMENT_CHUNKS(N, A, T, F) \
+    inline size_t A##_chunks(const N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        if(!vec->len) return 0; \
+        return vec_seg_log2((vec->len - 1) / VEC_SEG_BASE + 1) + 1; \
+    }
+
+/**
+ * @brief A##_chunk - get the items of a chunk as one contiguous array
+ * @param vec - the segmented vector
+ * @param k - the chunk, below A##_chunks
+ * @param items - write back for the first item of the chunk
+ * @return number of items in the chunk
+ */
+#define VEC_SEG_IMPLEMENT_CHUNK(N, A, T, F) \
+    inline size_t A##_chunk(const N *vec, size_t k, T **items) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        VEC_ASSERT_REAL(items); \
+        VEC_ASSERT_REAL(k < A##_chunks(vec)); \
+        size_t begin = VEC_SEG_BASE * (((size_t)1 << k) - 1); \
+        size_t size = A##_static_chunk_size(k); \
+        *items = vec->directory[k]; \
+        return vec->len - begin < size ? vec->len - begin : size; \
+    }
+
+/**
+ * @brief A##_free - free all chunks and all of their slots
+ * @param vec - the segmented vector
+ * @return void
+ */
+#define VEC_SEG_IMPLEMENT_FREE(N, A, T, F) \
+    inline void A##_free(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        for(size_t k = 0; k < vec->chunks; k++) { \
+            if(F != 0) { \
+                for(size_t i = 0; i < A##_static_chunk_size(k); i++) { \
+                    VEC_TYPE_FREE(F, &vec->directory[k][i], T); \
+                } \
+            } \
+            vec_free(vec->directory[k]); \
+        } \
+        A##_zero(vec); \
+    }
+
+/**
+ * @brief A##_zero - set the struct without freeing to zero
+ * @param vec - the segmented vector
+ * @return void
+ */
+#define VEC_SEG_IMPLEMENT_ZERO(N, A, T, F) \
+    inline void A##_zero(N *vec) \
+    { \
+        VEC_ASSERT_REAL(vec); \
+        vec_memset(vec, 0, sizeof(*vec)); \
+    }
+
+#define VEC_SEG_H
+#endif
+
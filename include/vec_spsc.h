@@ -0,0 +1,276 @@
+/* MIT License
+
+Copyright (c) 2023 rphii
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef VEC_SPSC_H
+
+#include <stdatomic.h>
+
+#include "vec.h"
+
+/*
+ * === THE SPSC QUEUE DESCRIPTION ===
+ * a bounded, lock-free queue for exactly one producer thread and one
+ * consumer thread. head (consumer) and tail (producer) only ever increase
+ * and each lives on its own cache line, next to a cached copy of the other
+ * side's index, so a thread only touches the other's line when the queue
+ * looks full (producer) or empty (consumer). the capacity is a power of two
+ * and fixed by A##_init. items are copied in and out by value.
+ */
+
+/**********************************************************/
+/* DECLARATION ********************************************/
+/**********************************************************/
+
+/*
+ * N = name - the name of the queue struct
+ * A = abbreviation - the prefix of the functions
+ * T = type - the type of the items
+ */
+
+#define VEC_SPSC_INCLUDE(N, A, T) \
+    typedef struct N { \
+        /* consumer side */ \
+        _Alignas(VEC_CACHE_LINE) atomic_size_t head; \
+        size_t tail_cached; \
+        /* producer side */ \
+        _Alignas(VEC_CACHE_LINE) atomic_size_t tail; \
+        size_t head_cached; \
+        /* shared, read only */ \
+        _Alignas(VEC_CACHE_LINE) size_t cap; \
+        T *items; \
+    } N; \
+    \
+    int A##_init(N *queue, size_t cap); \
+    void A##_free(N *queue); \
+    size_t A##_capacity(const N *queue); \
+    size_t A##_length(N *queue); \
+    int A##_try_push(N *queue, T val); \
+    int A##_try_pop(N *queue, T *val); \
+    size_t A##_push_n(N *queue, const T *vals, size_t n); \
+    size_t A##_pop_n(N *queue, T *vals, size_t n); \
+
+/**********************************************************/
+/* IMPLEMENTATION *****************************************/
+/**********************************************************/
+
+#define VEC_SPSC_IMPLEMENT(N, A, T) \
+    /* private */ \
+    VEC_SPSC_IMPLEMENT_STATIC_COPY_IN(N, A, T);     \
+    VEC_SPSC_IMPLEMENT_STATIC_COPY_OUT(N, A, T);    \
+    /* public */ \
+    VEC_SPSC_IMPLEMENT_INIT(N, A, T);               \
+    VEC_SPSC_IMPLEMENT_FREE(N, A, T);               \
+    VEC_SPSC_IMPLEMENT_CAPACITY(N, A, T);           \
+    VEC_SPSC_IMPLEMENT_LENGTH(N, A, T);             \
+    VEC_SPSC_IMPLEMENT_PUSH_N(N, A, T);             \
+    VEC_SPSC_IMPLEMENT_POP_N(N, A, T);              \
+    VEC_SPSC_IMPLEMENT_TRY_PUSH(N, A, T);           \
+    VEC_SPSC_IMPLEMENT_TRY_POP(N, A, T);            \
+
+/**********************************************************/
+/* PRIVATE FUNCTION IMPLEMENTATIONS ***********************/
+/**********************************************************/
+
+/**
+ * @brief A##_static_copy_in - internal use, copy items into the slots starting at a position, wrapping around
+ * @param queue - the queue
+ * @param pos - the (unmasked) position of the first slot
+ * @param vals - the items
+ * @param n - number of items
+ * @return void
+ */
+#define VEC_SPSC_IMPLEMENT_STATIC_COPY_IN(N, A, T) \
+    static inline void A##_static_copy_in(N *queue, size_t pos, const T *vals, size_t n) \
+    { \
+        size_t index = pos & (queue->cap - 1); \
+        size_t until_end = queue->cap - index; \
+        size_t len1 = n < until_end ? n : until_end; \
+        vec_memcpy(&queue->items[index], vals, sizeof(T) * len1); \
+        vec_memcpy(queue->items, vals + len1, sizeof(T) * (n - len1)); \
+    }
+
+/**
+ * @brief A##_static_copy_out - internal use, copy items out of the slots starting at a position, wrapping around
+ * @param queue - the queue
+ * @param pos - the (unmasked) position of the first slot
+ * @param vals - where to copy the items to
+ * @param n - number of items
+ * @return void
+ */
+#define VEC_SPSC_IMPLEMENT_STATIC_COPY_OUT(N, A, T) \
+    static inline void A##_static_copy_out(N *queue, size_t pos, T *vals, size_t n) \
+    { \
+        size_t index = pos & (queue->cap - 1); \
+        size_t until_end = queue->cap - index; \
+        size_t len1 = n < until_end ? n : until_end; \
+        vec_memcpy(vals, &queue->items[index], sizeof(T) * len1); \
+        vec_memcpy(vals + len1, queue->items, sizeof(T) * (n - len1)); \
+    }
+
+/**********************************************************/
+/* PUBLIC FUNCTION IMPLEMENTATIONS ************************/
+/**********************************************************/
+
+/**
+ * @brief A##_init - set up an empty queue, before any thread uses it
+ * @param queue - the queue
+ * @param cap - minimum number of items it can hold (rounded up to a power of two)
+ * @return zero if success, non-zero if failure
+ */
+#define VEC_SPSC_IMPLEMENT_INIT(N, A, T) \
+    inline int A##_init(N *queue, size_t cap) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        size_t required = 1; \
+        while(required < cap) required *= 2; \
+        queue->items = vec_malloc(sizeof(T) * required); \
+        if(!queue->items) return VEC_ERROR_MALLOC; \
+        queue->cap = required; \
+        atomic_init(&queue->head, 0); \
+        atomic_init(&queue->tail, 0); \
+        queue->head_cached = 0; \
+        queue->tail_cached = 0; \
+        return VEC_ERROR_NONE; \
+    }
+
+/**
+ * @brief A##_free - free the queue, once no thread uses it anymore
+ * @param queue - the queue
+ * @return void
+ */
+#define VEC_SPSC_IMPLEMENT_FREE(N, A, T) \
+    inline void A##_free(N *queue) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        vec_free(queue->items); \
+        queue->items = 0; \
+        queue->cap = 0; \
+    }
+
+/**
+ * @brief A##_capacity - get the number of items the queue can hold
+ * @param queue - the queue
+ * @return capacity in items
+ */
+#define VEC_SPSC_IMPLEMENT_CAPACITY(N, A, T) \
+    inline size_t A##_capacity(const N *queue) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        return queue->cap; \
+    }
+
+/**
+ * @brief A##_length - get the number of queued items (only a snapshot while the other side is active)
+ * @param queue - the queue
+ * @return length in items
+ */
+#define VEC_SPSC_IMPLEMENT_LENGTH(N, A, T) \
+    inline size_t A##_length(N *queue) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        size_t head = atomic_load_explicit(&queue->head, memory_order_acquire); \
+        size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire); \
+        return tail - head; \
+    }
+
+/**
+ * @brief A##_push_n - enqueue as many items of a span as there is room for (producer only)
+ * @param queue - the queue
+ * @param vals - the items
+ * @param n - number of items
+ * @return number of items enqueued
+ */
+#define VEC_SPSC_IMPLEMENT_PUSH_N(N, A, T) \
+    inline size_t A##_push_n(N *queue, const T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        VEC_ASSERT_REAL(vals || !n); \
+        size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed); \
+        size_t room = queue->cap - (tail - queue->head_cached); \
+        if(room < n) { \
+            /* only look at the consumer's line if we have to */ \
+            queue->head_cached = atomic_load_explicit(&queue->head, memory_order_acquire); \
+            room = queue->cap - (tail - queue->head_cached); \
+            if(n > room) n = room; \
+        } \
+        if(!n) return 0; \
+        A##_static_copy_in(queue, tail, vals, n); \
+        atomic_store_explicit(&queue->tail, tail + n, memory_order_release); \
+        return n; \
+    }
+
+/**
+ * @brief A##_pop_n - dequeue up to n items into a span (consumer only)
+ * @param queue - the queue
+ * @param vals - where to copy the items to
+ * @param n - maximum number of items
+ * @return number of items dequeued
+ */
+#define VEC_SPSC_IMPLEMENT_POP_N(N, A, T) \
+    inline size_t A##_pop_n(N *queue, T *vals, size_t n) \
+    { \
+        VEC_ASSERT_REAL(queue); \
+        VEC_ASSERT_REAL(vals || !n); \
+        size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed); \
+        size_t avail = queue->tail_cached - head; \
+        if(avail < n) { \
+            /* only look at the producer's line if we have to */ \
+            queue->tail_cached = atomic_load_explicit(&queue->tail, memory_order_acquire); \
+            avail = queue->tail_cached - head; \
+            if(n > avail) n = avail; \
+        } \
+        if(!n) return 0; \
+        A##_static_copy_out(queue, head, vals, n); \
+        atomic_store_explicit(&queue->head, head + n, memory_order_release); \
+        return n; \
+    }
+
+/**
+ * @brief A##_try_push - enqueue one item (producer only)
+ * @param queue - the queue
+ * @param val - the item
+ * @return boolean: true if enqueued, false if the queue is full
+ */
+#define VEC_SPSC_IMPLEMENT_TRY_PUSH(N, A, T) \
+    inline int A##_try_push(N *queue, T val) \
+    { \
+        return A##_push_n(queue, &val, 1) == 1; \
+    }
+
+/**
+ * @brief A##_try_pop - dequeue one item (consumer only)
+ * @param queue - the queue
+ * @param val - write back for the item, pass 0 to ignore
+ * @return boolean: true if dequeued, false if the queue is empty
+ */
+#define VEC_SPSC_IMPLEMENT_TRY_POP(N, A, T) \
+    inline int A##_try_pop(N *queue, T *val) \
+    { \
+        T temp; \
+        if(!A##_pop_n(queue, &temp, 1)) return 0; \
+        if(val) *val = temp; \
+        return 1; \
+    }
+
+#define VEC_SPSC_H
+#endif
+
@@ -0,0 +1,23 @@
+#ifndef BENCH_H
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+/* seconds since an arbitrary point in time */
+static inline double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* keep the optimizer from discarding a result */
+static inline void bench_keep(const void *p)
+{
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+#define BENCH_H
+#endif
+
@@ -0,0 +1,66 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#include "vec.h"
+#include "vec_gap.h"
+
+VEC_INCLUDE(BStr, bstr, char, BY_VAL);
+VEC_IMPLEMENT(BStr, bstr, char, BY_VAL, 0);
+
+VEC_GAP_INCLUDE(BGap, bgap, char, BStr);
+VEC_GAP_IMPLEMENT(BGap, bgap, char, BStr, bstr);
+
+/* edits per cluster, all within a few characters of each other */
+#define BENCH_GAP_CLUSTER 64
+
+int main(void)
+{
+    for(size_t n = 10000; n <= 1000000; n *= 10) {
+        size_t clusters = 1000;
+        BStr str = {0};
+        for(size_t i = 0; i < n; i++) bstr_push_back(&str, 'a' + i % 26);
+        BGap gap = {0};
+        bgap_load(&gap, &str);
+
+        srand(1);
+        double t0 = bench_now();
+        for(size_t c = 0; c < clusters; c++) {
+            size_t at = (size_t)rand() % bstr_length(&str);
+            for(size_t i = 0; i < BENCH_GAP_CLUSTER; i++) {
+                bstr_push_at(&str, at + i, 'x');
+            }
+            for(size_t i = 0; i < BENCH_GAP_CLUSTER / 2; i++) {
+                bstr_pop_at(&str, at, 0);
+            }
+        }
+        double t1 = bench_now();
+        srand(1);
+        for(size_t c = 0; c < clusters; c++) {
+            size_t at = (size_t)rand() % bgap_length(&gap);
+            bgap_move_to(&gap, at);
+            for(size_t i = 0; i < BENCH_GAP_CLUSTER; i++) {
+                bgap_insert(&gap, 'x');
+            }
+            bgap_move_to(&gap, at);
+            bgap_erase_after(&gap, BENCH_GAP_CLUSTER / 2);
+        }
+        BStr flat = {0};
+        bgap_flatten(&gap, &flat);
+        double t2 = bench_now();
+
+        if(bstr_length(&flat) != bstr_length(&str) || memcmp(bstr_iter_begin(&flat), bstr_iter_begin(&str), bstr_length(&str))) {
+            printf("mismatch\n");
+            return 1;
+        }
+        printf("%8zu chars, %zu clusters of %u edits : push_at/pop_at %9.3f ms, gap buffer + flatten %8.3f ms\n",
+                n, clusters, BENCH_GAP_CLUSTER, (t1 - t0) * 1e3, (t2 - t1) * 1e3);
+        bstr_free(&str);
+        bstr_free(&flat);
+        bgap_free(&gap);
+    }
+    return 0;
+}
+
@@ -0,0 +1,100 @@
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vec.h"
+
+typedef struct Counter {
+    size_t reallocs;
+    size_t bytes;
+    size_t peak;
+} Counter;
+
+static void *counter_alloc(void *user, size_t size)
+{
+    Counter *counter = user;
+    counter->bytes += size;
+    if(counter->bytes > counter->peak) counter->peak = counter->bytes;
+    return malloc(size);
+}
+
+static void *counter_realloc(void *user, void *ptr, size_t size_old, size_t size_new)
+{
+    Counter *counter = user;
+    counter->reallocs++;
+    counter->bytes += size_new - size_old;
+    if(counter->bytes > counter->peak) counter->peak = counter->bytes;
+    return realloc(ptr, size_new);
+}
+
+static void counter_free(void *user, void *ptr, size_t size)
+{
+    Counter *counter = user;
+    counter->bytes -= size;
+    free(ptr);
+}
+
+#define BENCH_GROWTH_VEC(N, A) \
+    VEC_INCLUDE(N, A, uint64_t, BY_VAL); \
+    VEC_IMPLEMENT(N, A, uint64_t, BY_VAL, 0);
+
+#define VEC_SETTINGS_GROWTH vec_growth_double
+#include "vec.h"
+BENCH_GROWTH_VEC(VDouble, vdouble)
+#undef VEC_SETTINGS_GROWTH
+
+#define VEC_SETTINGS_GROWTH vec_growth_1_5
+#include "vec.h"
+BENCH_GROWTH_VEC(V1_5, v1_5)
+#undef VEC_SETTINGS_GROWTH
+
+#define VEC_SETTINGS_GROWTH vec_growth_golden
+#include "vec.h"
+BENCH_GROWTH_VEC(VGolden, vgolden)
+#undef VEC_SETTINGS_GROWTH
+
+#define VEC_SETTINGS_GROWTH vec_growth_fixed
+#define VEC_SETTINGS_GROWTH_PARAM (1 << 16)
+#include "vec.h"
+BENCH_GROWTH_VEC(VFixed, vfixed)
+#undef VEC_SETTINGS_GROWTH_PARAM
+#undef VEC_SETTINGS_GROWTH
+
+#define VEC_SETTINGS_GROWTH vec_growth_page
+#include "vec.h"
+BENCH_GROWTH_VEC(VPage, vpage)
+#undef VEC_SETTINGS_GROWTH
+
+#define BENCH_GROWTH(A, N, n) do { \
+        Counter counter = {0}; \
+        VecAllocator allocator = { counter_alloc, counter_realloc, counter_free, &counter }; \
+        N vec = { .allocator = &allocator }; \
+        double t0 = bench_now(); \
+        for(uint64_t i = 0; i < n; i++) { \
+            A##_push_back(&vec, i); \
+        } \
+        double t1 = bench_now(); \
+        size_t used = A##_length(&vec) * sizeof(uint64_t); \
+        printf("%-8s : %6zu reallocs, %10zu bytes reserved, %5.1f%% spare, peak %10zu bytes, %8.3f ms\n", \
+                #A, counter.reallocs, A##_reserved(&vec), \
+                100.0 * (double)(A##_reserved(&vec) - used) / (double)A##_reserved(&vec), \
+                counter.peak, (t1 - t0) * 1e3); \
+        A##_free(&vec); \
+    } while(0)
+
+int main(void)
+{
+    size_t sizes[] = { 1000000, 5000000, 20000000 };
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+        size_t n = sizes[s];
+        printf("--- %zu items ---\n", n);
+        BENCH_GROWTH(vdouble, VDouble, n);
+        BENCH_GROWTH(v1_5, V1_5, n);
+        BENCH_GROWTH(vgolden, VGolden, n);
+        BENCH_GROWTH(vfixed, VFixed, n);
+        BENCH_GROWTH(vpage, VPage, n);
+    }
+    return 0;
+}
+
@@ -0,0 +1,54 @@
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vec.h"
+
+/* default allocation */
+VEC_INCLUDE(Vu64, vu64, uint64_t, BY_VAL);
+VEC_IMPLEMENT(Vu64, vu64, uint64_t, BY_VAL, 0);
+
+/* 2 MB aligned, advised as huge pages from 64 MB on */
+#define VEC_SETTINGS_HUGEPAGE_THRESHOLD 0x4000000
+#include "vec.h"
+VEC_INCLUDE(HVu64, hvu64, uint64_t, BY_VAL);
+VEC_IMPLEMENT(HVu64, hvu64, uint64_t, BY_VAL, 0);
+#undef VEC_SETTINGS_HUGEPAGE_THRESHOLD
+
+static inline uint64_t bench_xorshift(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+#define BENCH_HUGEPAGE(A, N, n, reads) do { \
+        N vec = {0}; \
+        for(uint64_t i = 0; i < n; i++) { \
+            A##_push_back(&vec, i); \
+        } \
+        uint64_t state = 88172645463325252ULL; \
+        uint64_t sum = 0; \
+        double t0 = bench_now(); \
+        for(size_t r = 0; r < reads; r++) { \
+            sum += A##_get_at(&vec, bench_xorshift(&state) % n); \
+        } \
+        double t1 = bench_now(); \
+        bench_keep(&sum); \
+        printf("%-8s %6zu MB : %8.2f M reads/s\n", #A, (size_t)(n * sizeof(uint64_t)) >> 20, reads / (t1 - t0) * 1e-6); \
+        A##_free(&vec); \
+    } while(0)
+
+/* usage: bench_hugepage [MB] */
+int main(int argc, char **argv)
+{
+    size_t mb = argc > 1 ? (size_t)strtoull(argv[1], 0, 10) : 1024;
+    size_t n = (mb << 20) / sizeof(uint64_t);
+    size_t reads = 50000000;
+    BENCH_HUGEPAGE(vu64, Vu64, n, reads);
+    BENCH_HUGEPAGE(hvu64, HVu64, n, reads);
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "bench.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "vec_mpmc.h"
+
+#define BENCH_ITEMS     4000000ULL
+#define BENCH_BATCH     16
+
+/* a person-sized record */
+typedef struct Person {
+    char name[48];
+    uint32_t age;
+    uint32_t id;
+    uint64_t flags;
+} Person;
+
+VEC_MPMC_INCLUDE(MPerson, mperson, Person);
+VEC_MPMC_IMPLEMENT(MPerson, mperson, Person);
+
+static MPerson queue;
+static size_t batch = 1;
+static size_t threads = 1;
+static atomic_size_t consumed;
+
+static void *bench_mpmc_producer(void *arg)
+{
+    (void) arg;
+    Person vals[BENCH_BATCH] = {0};
+    size_t items = BENCH_ITEMS / threads;
+    for(size_t i = 0; i < items; ) {
+        size_t n = items - i < batch ? items - i : batch;
+        for(size_t k = 0; k < n; k++) vals[k].id = (uint32_t)(i + k);
+        size_t pushed = batch == 1 ? (size_t)mperson_try_push(&queue, vals[0]) : mperson_push_n(&queue, vals, n);
+        /* full, let the consumers run (matters on few cores) */
+        if(!pushed) sched_yield();
+        i += pushed;
+    }
+    return 0;
+}
+
+static void *bench_mpmc_consumer(void *arg)
+{
+    uint64_t *sum = arg;
+    Person vals[BENCH_BATCH];
+    size_t total = BENCH_ITEMS / threads * threads;
+    while(atomic_load_explicit(&consumed, memory_order_relaxed) < total) {
+        size_t n = batch == 1 ? (size_t)mperson_try_pop(&queue, vals) : mperson_pop_n(&queue, vals, batch);
+        if(!n) {
+            sched_yield();
+            continue;
+        }
+        for(size_t k = 0; k < n; k++) *sum += vals[k].id;
+        atomic_fetch_add_explicit(&consumed, n, memory_order_relaxed);
+    }
+    return 0;
+}
+
+/* threads producers and threads consumers */
+static void bench_mpmc(void)
+{
+    pthread_t producers[threads], consumers[threads];
+    uint64_t sums[threads];
+    mperson_init(&queue, 4096);
+    atomic_store(&consumed, 0);
+    double t0 = bench_now();
+    for(size_t i = 0; i < threads; i++) {
+        sums[i] = 0;
+        pthread_create(&producers[i], 0, bench_mpmc_producer, 0);
+        pthread_create(&consumers[i], 0, bench_mpmc_consumer, &sums[i]);
+    }
+    for(size_t i = 0; i < threads; i++) {
+        pthread_join(producers[i], 0);
+        pthread_join(consumers[i], 0);
+    }
+    double t1 = bench_now();
+    bench_keep(sums);
+    printf("mpmc %2zu+%-2zu threads, batch %-3zu : %8.2f M items/s\n",
+            threads, threads, batch, (double)(BENCH_ITEMS / threads * threads) / (t1 - t0) * 1e-6);
+    mperson_free(&queue);
+}
+
+/* usage: bench_mpmc [max producer threads, default: number of cpus] */
+int main(int argc, char **argv)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max = argc > 1 ? (size_t)strtoull(argv[1], 0, 10) : (size_t)(cpus > 0 ? cpus : 1);
+    if(!max) max = 1;
+    printf("sizeof(Person) = %zu\n", sizeof(Person));
+    for(threads = 1; threads <= max; threads *= 2) {
+        for(batch = 1; batch <= BENCH_BATCH; batch *= BENCH_BATCH) {
+            bench_mpmc();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vec.h"
+
+VEC_INCLUDE(Vu32, vu32, uint32_t, BY_VAL);
+VEC_IMPLEMENT(Vu32, vu32, uint32_t, BY_VAL, 0);
+
+static int is_odd(const uint32_t *item, void *ctx)
+{
+    (void) ctx;
+    return *item & 1;
+}
+
+static void fill(Vu32 *v, size_t n)
+{
+    vu32_clear(v);
+    for(size_t i = 0; i < n; i++) vu32_push_back(v, (uint32_t)i);
+}
+
+int main(void)
+{
+    Vu32 v = {0};
+    size_t *indices = malloc(sizeof(*indices) * 10000000 / 2);
+    if(!indices) return 1;
+    for(size_t n = 1000; n <= 10000000; n *= 10) {
+        /* popping every other item one by one is quadratic, only time it while bearable */
+        double t_pop = -1;
+        if(n <= 100000) {
+            fill(&v, n);
+            double t0 = bench_now();
+            for(size_t i = 0; i < n / 2; i++) vu32_pop_at(&v, i, 0);
+            t_pop = bench_now() - t0;
+        }
+        fill(&v, n);
+        double t0 = bench_now();
+        vu32_retain(&v, is_odd, 0);
+        double t1 = bench_now();
+        bench_keep(vu32_iter_begin(&v));
+        fill(&v, n);
+        double t2 = bench_now();
+        vu32_erase_range(&v, n / 4, n / 2);
+        double t3 = bench_now();
+        bench_keep(vu32_iter_begin(&v));
+        fill(&v, n);
+        double t4 = bench_now();
+        for(size_t i = 0; i < n / 2; i++) vu32_swap_remove(&v, i, 0);
+        double t5 = bench_now();
+        bench_keep(vu32_iter_begin(&v));
+        fill(&v, n);
+        for(size_t i = 0; i < n / 2; i++) indices[i] = 2 * i;
+        double t6 = bench_now();
+        vu32_swap_remove_n(&v, indices, n / 2);
+        double t7 = bench_now();
+        bench_keep(vu32_iter_begin(&v));
+
+        if(t_pop < 0) printf("%10zu items : pop_at half %13s, ", n, "-");
+        else printf("%10zu items : pop_at half %10.3f ms, ", n, t_pop * 1e3);
+        printf("retain half %8.3f ms, erase_range half %8.3f ms, swap_remove half %8.3f ms, swap_remove_n half %8.3f ms\n",
+                (t1 - t0) * 1e3, (t3 - t2) * 1e3, (t5 - t4) * 1e3, (t7 - t6) * 1e3);
+    }
+    vu32_free(&v);
+    free(indices);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "bench.h"
+
+#include <stdint.h>
+
+#include "vec.h"
+
+VEC_INCLUDE(Vu8, vu8, uint8_t, BY_VAL);
+VEC_IMPLEMENT(Vu8, vu8, uint8_t, BY_VAL, 0);
+VEC_INCLUDE(Vu32, vu32, uint32_t, BY_VAL);
+VEC_IMPLEMENT(Vu32, vu32, uint32_t, BY_VAL, 0);
+VEC_INCLUDE(Vu64, vu64, uint64_t, BY_VAL);
+VEC_IMPLEMENT(Vu64, vu64, uint64_t, BY_VAL, 0);
+
+#if defined(__AVX2__)
+#define KERNEL "avx2"
+#elif defined(__SSSE3__)
+#define KERNEL "ssse3"
+#else
+#define KERNEL "scalar (build with BENCH_ARCH=-march=native for the shuffle kernels)"
+#endif
+
+/* A##_reverse before the kernels: one A##_swap per pair */
+#define REVERSE_OLD(N, A) \
+    __attribute__((noinline)) static void A##_reverse_old(N *vec) \
+    { \
+        size_t len = A##_length(vec); \
+        size_t len2 = len / 2; \
+        for(size_t i = 0; i < len2; i++) { \
+            A##_swap(vec, i, len - i - 1); \
+        } \
+    }
+
+REVERSE_OLD(Vu8, vu8)
+REVERSE_OLD(Vu32, vu32)
+REVERSE_OLD(Vu64, vu64)
+
+/* reverse a vector of bytes bytes rounds times each way, check it and print the ns per round */
+#define BENCH_REVERSE(N, A, T, bytes) \
+    do { \
+        size_t n = (bytes) / sizeof(T); \
+        size_t rounds = ((size_t)1 << 28) / (bytes); \
+        N v = {0}; \
+        if(A##_resize(&v, n)) return 1; \
+        for(size_t i = 0; i < n; i++) *A##_iter_at(&v, i) = (T)i; \
+        double t0 = bench_now(); \
+        for(size_t r = 0; r < rounds; r++) { \
+            A##_reverse_old(&v); \
+            bench_keep(A##_iter_begin(&v)); \
+        } \
+        double t1 = bench_now(); \
+        for(size_t r = 0; r < rounds; r++) { \
+            vec_reverse_scalar((unsigned char *)A##_iter_begin(&v), (unsigned char *)A##_iter_end(&v), sizeof(T)); \
+            bench_keep(A##_iter_begin(&v)); \
+        } \
+        double t2 = bench_now(); \
+        for(size_t r = 0; r < rounds; r++) { \
+            A##_reverse(&v); \
+            bench_keep(A##_iter_begin(&v)); \
+        } \
+        double t3 = bench_now(); \
+        /* reversed an even number of times */ \
+        for(size_t i = 0; i < n; i++) { \
+            if(A##_get_at(&v, i) != (T)i) { \
+                printf("mismatch at %zu\n", i); \
+                return 1; \
+            } \
+        } \
+        printf("%-6s %8zu bytes : old reverse %10.1f ns, scalar %10.1f ns, kernel %10.1f ns (%5.1fx)\n", \
+                #A, (size_t)(bytes), (t1 - t0) * 1e9 / rounds, (t2 - t1) * 1e9 / rounds, \
+                (t3 - t2) * 1e9 / rounds, (t1 - t0) / (t3 - t2)); \
+        A##_free(&v); \
+    } while(0)
+
+int main(void)
+{
+    printf("kernel: %s\n", KERNEL);
+    /* small enough to stay in the caches, so the kernel is timed and not the memory */
+    for(size_t bytes = 1024; bytes <= 256 * 1024; bytes *= 4) {
+        BENCH_REVERSE(Vu8, vu8, uint8_t, bytes);
+        BENCH_REVERSE(Vu32, vu32, uint32_t, bytes);
+        BENCH_REVERSE(Vu64, vu64, uint64_t, bytes);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#include "vec.h"
+#include "vec_rope.h"
+
+VEC_INCLUDE(BStr, bstr, char, BY_VAL);
+VEC_IMPLEMENT(BStr, bstr, char, BY_VAL, 0);
+
+VEC_ROPE_INCLUDE(BRope, brope, char, BStr);
+VEC_ROPE_IMPLEMENT(BRope, brope, char, BStr, bstr);
+
+#define BENCH_ROPE_LINE "the quick brown fox jumps over the lazy dog, line %zu\n"
+#define BENCH_ROPE_INSERTS 1000
+
+/* append the way str_fmt does, by reserving and writing behind the last item */
+static void bench_str_append(BStr *str, const char *s, size_t n)
+{
+    bstr_reserve(str, bstr_length(str) + n);
+    memcpy(bstr_iter_end(str), s, n);
+    str->last += n;
+}
+
+/* insert by moving the tail back */
+static void bench_str_insert(BStr *str, size_t index, const char *s, size_t n)
+{
+    bstr_reserve(str, bstr_length(str) + n);
+    char *at = bstr_iter_begin(str) + index;
+    memmove(at + n, at, bstr_length(str) - index);
+    memcpy(at, s, n);
+    str->last += n;
+}
+
+int main(void)
+{
+    char line[128];
+    for(size_t lines = 100000; lines <= 4000000; lines *= 4) {
+        BStr str = {0}, flat = {0};
+        BRope rope = {0};
+
+        double t0 = bench_now();
+        for(size_t i = 0; i < lines; i++) {
+            int n = snprintf(line, sizeof(line), BENCH_ROPE_LINE, i);
+            bench_str_append(&str, line, (size_t)n);
+        }
+        double t1 = bench_now();
+        for(size_t i = 0; i < lines; i++) {
+            int n = snprintf(line, sizeof(line), BENCH_ROPE_LINE, i);
+            brope_append_n(&rope, line, (size_t)n);
+        }
+        double t2 = bench_now();
+
+        srand(1);
+        for(size_t i = 0; i < BENCH_ROPE_INSERTS; i++) {
+            bench_str_insert(&str, (size_t)rand() % bstr_length(&str), "inserted", 8);
+        }
+        double t3 = bench_now();
+        srand(1);
+        for(size_t i = 0; i < BENCH_ROPE_INSERTS; i++) {
+            brope_insert_at(&rope, (size_t)rand() % brope_length(&rope), "inserted", 8);
+        }
+        double t4 = bench_now();
+        brope_flatten(&rope, &flat);
+        double t5 = bench_now();
+
+        if(bstr_length(&flat) != bstr_length(&str) || memcmp(bstr_iter_begin(&flat), bstr_iter_begin(&str), bstr_length(&str))) {
+            printf("mismatch\n");
+            return 1;
+        }
+        printf("%10zu bytes : append str %8.3f ms, rope %8.3f ms | %u inserts str %9.3f ms, rope %6.3f ms | flatten %8.3f ms\n",
+                bstr_length(&str), (t1 - t0) * 1e3, (t2 - t1) * 1e3,
+                BENCH_ROPE_INSERTS, (t3 - t2) * 1e3, (t4 - t3) * 1e3, (t5 - t4) * 1e3);
+        bstr_free(&str);
+        bstr_free(&flat);
+        brope_free(&rope);
+    }
+    return 0;
+}
+
@@ -0,0 +1,68 @@
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vec.h"
+#include "vec_seg.h"
+
+/* contiguous */
+VEC_INCLUDE(Vu64, vu64, uint64_t, BY_VAL);
+VEC_IMPLEMENT(Vu64, vu64, uint64_t, BY_VAL, 0);
+
+/* segmented */
+VEC_SEG_INCLUDE(Sgu64, sgu64, uint64_t);
+VEC_SEG_IMPLEMENT(Sgu64, sgu64, uint64_t, 0);
+
+#define BENCH_SEG_SCAN 20
+
+int main(void)
+{
+    for(size_t n = 1000; n <= 10000000; n *= 10) {
+        Vu64 vec = {0};
+        Sgu64 seg = {0};
+        uint64_t sum_vec = 0, sum_seg = 0, sum_index = 0;
+
+        double t0 = bench_now();
+        for(uint64_t i = 0; i < n; i++) vu64_push_back(&vec, i);
+        double t1 = bench_now();
+        for(uint64_t i = 0; i < n; i++) sgu64_push_back(&seg, i);
+        double t2 = bench_now();
+
+        for(size_t r = 0; r < BENCH_SEG_SCAN; r++) {
+            for(uint64_t *it = vu64_iter_begin(&vec); it < vu64_iter_end(&vec); it++) {
+                sum_vec += *it;
+            }
+            bench_keep(&sum_vec);
+        }
+        double t3 = bench_now();
+        for(size_t r = 0; r < BENCH_SEG_SCAN; r++) {
+            for(size_t k = 0; k < sgu64_chunks(&seg); k++) {
+                uint64_t *items;
+                size_t len = sgu64_chunk(&seg, k, &items);
+                for(size_t i = 0; i < len; i++) sum_seg += items[i];
+            }
+            bench_keep(&sum_seg);
+        }
+        double t4 = bench_now();
+        for(size_t r = 0; r < BENCH_SEG_SCAN; r++) {
+            for(size_t i = 0; i < sgu64_length(&seg); i++) {
+                sum_index += sgu64_get_at(&seg, i);
+            }
+            bench_keep(&sum_index);
+        }
+        double t5 = bench_now();
+
+        if(sum_vec != sum_seg || sum_vec != sum_index) {
+            printf("mismatch\n");
+            return 1;
+        }
+        printf("%8zu items : push vec %8.3f ms, seg %8.3f ms | scan vec %8.3f ms, seg chunks %8.3f ms, seg index %8.3f ms\n",
+                n, (t1 - t0) * 1e3, (t2 - t1) * 1e3,
+                (t3 - t2) * 1e3 / BENCH_SEG_SCAN, (t4 - t3) * 1e3 / BENCH_SEG_SCAN, (t5 - t4) * 1e3 / BENCH_SEG_SCAN);
+        vu64_free(&vec);
+        sgu64_free(&seg);
+    }
+    return 0;
+}
+
@@ -0,0 +1,46 @@
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vec.h"
+
+/* per-slot malloc (default) */
+VEC_INCLUDE(RVu64, rvu64, uint64_t, BY_REF);
+VEC_IMPLEMENT(RVu64, rvu64, uint64_t, BY_REF, 0);
+
+/* slab storage */
+#define VEC_SETTINGS_SLAB 1
+#include "vec.h"
+VEC_INCLUDE(SRVu64, srvu64, uint64_t, BY_REF);
+VEC_IMPLEMENT(SRVu64, srvu64, uint64_t, BY_REF, 0);
+#undef VEC_SETTINGS_SLAB
+
+#define BENCH_SLAB(A, N, n, rounds) do { \
+        double t0 = bench_now(); \
+        uint64_t sum = 0; \
+        for(size_t r = 0; r < rounds; r++) { \
+            N vec = {0}; \
+            for(uint64_t i = 0; i < n; i++) { \
+                A##_push_back(&vec, &i); \
+            } \
+            for(uint64_t **it = A##_iter_begin(&vec); it < A##_iter_end(&vec); it++) { \
+                sum += **it; \
+            } \
+            A##_free(&vec); \
+        } \
+        double t1 = bench_now(); \
+        bench_keep(&sum); \
+        printf("%-8s %8zu items : %8.3f ms per round\n", #A, (size_t)n, (t1 - t0) * 1e3 / rounds); \
+    } while(0)
+
+int main(void)
+{
+    for(size_t n = 1000; n <= 1000000; n *= 10) {
+        size_t rounds = 10000000 / n;
+        BENCH_SLAB(rvu64, RVu64, n, rounds);
+        BENCH_SLAB(srvu64, SRVu64, n, rounds);
+    }
+    return 0;
+}
+
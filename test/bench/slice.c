@@ -0,0 +1,47 @@
+#include "bench.h"
+
+#include <stdint.h>
+
+#include "vec.h"
+
+VEC_INCLUDE(Vu8, vu8, uint8_t, BY_VAL);
+VEC_IMPLEMENT(Vu8, vu8, uint8_t, BY_VAL, 0);
+
+int main(void)
+{
+    for(size_t n = 1000; n <= 100000000; n *= 10) {
+        size_t rounds = 100000000 / n;
+        Vu8 src = {0}, dst = {0};
+        for(size_t i = 0; i < n; i++) vu8_push_back(&src, (uint8_t)i);
+
+        double t0 = bench_now();
+        for(size_t r = 0; r < rounds; r++) {
+            vu8_clear(&dst);
+            for(size_t i = 0; i < n; i++) vu8_push_back(&dst, vu8_get_at(&src, i));
+        }
+        double t1 = bench_now();
+        for(size_t r = 0; r < rounds; r++) {
+            vu8_clear(&dst);
+            vu8_extend_back(&dst, &src, n);
+        }
+        double t2 = bench_now();
+        for(size_t r = 0; r < rounds; r++) {
+            vu8_cut_back(&dst, &src, n);
+            vu8_cut_back(&src, &dst, n);
+        }
+        double t3 = bench_now();
+        for(size_t r = 0; r < rounds; r++) {
+            vu8_clear(&dst);
+            vu8_push_back_n(&dst, vu8_iter_begin(&src), vu8_length(&src));
+        }
+        double t4 = bench_now();
+        bench_keep(vu8_iter_begin(&dst));
+
+        printf("%10zu bytes : push_back loop %9.3f ms, extend_back %8.3f ms, 2x cut_back %8.3f ms, push_back_n %8.3f ms\n",
+                n, (t1 - t0) * 1e3 / rounds, (t2 - t1) * 1e3 / rounds, (t3 - t2) * 1e3 / rounds, (t4 - t3) * 1e3 / rounds);
+        vu8_free(&src);
+        vu8_free(&dst);
+    }
+    return 0;
+}
+
@@ -0,0 +1,114 @@
+#include "bench.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "vec.h"
+#include "vec_spsc.h"
+
+#define BENCH_ITEMS     10000000ULL
+#define BENCH_BATCH     64
+
+/* lock-free queue */
+VEC_SPSC_INCLUDE(Qu64, qu64, uint64_t);
+VEC_SPSC_IMPLEMENT(Qu64, qu64, uint64_t);
+
+/* what we had before: a vector behind a mutex */
+VEC_INCLUDE(Vu64, vu64, uint64_t, BY_VAL);
+VEC_IMPLEMENT(Vu64, vu64, uint64_t, BY_VAL, 0);
+
+typedef struct Locked {
+    pthread_mutex_t mutex;
+    Vu64 vec;
+} Locked;
+
+static Qu64 queue;
+static Locked locked = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+static size_t batch = 1;
+
+static void *bench_spsc_producer(void *arg)
+{
+    (void) arg;
+    uint64_t vals[BENCH_BATCH];
+    for(uint64_t i = 0; i < BENCH_ITEMS; ) {
+        size_t n = 0;
+        while(n < batch && i + n < BENCH_ITEMS) {
+            vals[n] = i + n;
+            n++;
+        }
+        size_t pushed = batch == 1 ? (size_t)qu64_try_push(&queue, vals[0]) : qu64_push_n(&queue, vals, n);
+        /* full, let the consumer run (matters on few cores) */
+        if(!pushed) sched_yield();
+        i += pushed;
+    }
+    return 0;
+}
+
+static void *bench_locked_producer(void *arg)
+{
+    (void) arg;
+    for(uint64_t i = 0; i < BENCH_ITEMS; i++) {
+        pthread_mutex_lock(&locked.mutex);
+        vu64_push_back(&locked.vec, i);
+        pthread_mutex_unlock(&locked.mutex);
+    }
+    return 0;
+}
+
+static void bench_spsc(void)
+{
+    qu64_init(&queue, 4096);
+    pthread_t producer;
+    double t0 = bench_now();
+    pthread_create(&producer, 0, bench_spsc_producer, 0);
+    uint64_t vals[BENCH_BATCH];
+    uint64_t sum = 0;
+    for(uint64_t got = 0; got < BENCH_ITEMS; ) {
+        size_t n = batch == 1 ? (size_t)qu64_try_pop(&queue, vals) : qu64_pop_n(&queue, vals, batch);
+        for(size_t i = 0; i < n; i++) sum += vals[i];
+        if(!n) sched_yield();
+        got += n;
+    }
+    pthread_join(producer, 0);
+    double t1 = bench_now();
+    bench_keep(&sum);
+    printf("spsc   batch %-3zu : %8.2f M items/s\n", batch, BENCH_ITEMS / (t1 - t0) * 1e-6);
+    qu64_free(&queue);
+}
+
+static void bench_locked(void)
+{
+    pthread_t producer;
+    double t0 = bench_now();
+    pthread_create(&producer, 0, bench_locked_producer, 0);
+    uint64_t sum = 0;
+    for(uint64_t got = 0; got < BENCH_ITEMS; ) {
+        uint64_t val = 0;
+        pthread_mutex_lock(&locked.mutex);
+        if(!vu64_empty(&locked.vec)) {
+            vu64_pop_front(&locked.vec, &val);
+            sum += val;
+            got++;
+            pthread_mutex_unlock(&locked.mutex);
+        } else {
+            pthread_mutex_unlock(&locked.mutex);
+            sched_yield();
+        }
+    }
+    pthread_join(producer, 0);
+    double t1 = bench_now();
+    bench_keep(&sum);
+    printf("mutex  Vu64      : %8.2f M items/s\n", BENCH_ITEMS / (t1 - t0) * 1e-6);
+    vu64_free(&locked.vec);
+}
+
+int main(void)
+{
+    bench_locked();
+    for(batch = 1; batch <= BENCH_BATCH; batch *= 8) {
+        bench_spsc();
+    }
+    return 0;
+}
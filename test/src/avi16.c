@@ -0,0 +1,6 @@
+#include "avi16.h"
+
+#define VEC_SETTINGS_ALIGN 64
+
+VEC_IMPLEMENT(AVi16, avi16, int16_t, BY_VAL, 0);
+
@@ -0,0 +1,15 @@
+#ifndef AVI16_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_ALIGN 64
+
+#include "vec.h"
+VEC_INCLUDE(AVi16, avi16, int16_t, BY_VAL);
+
+#undef VEC_SETTINGS_ALIGN
+
+#define AVI16_H
+#endif
+
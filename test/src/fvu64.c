@@ -0,0 +1,7 @@
+#include "fvu64.h"
+
+#define VEC_SETTINGS_GROWTH vec_growth_fixed
+#define VEC_SETTINGS_GROWTH_PARAM 100
+
+VEC_IMPLEMENT(FVu64, fvu64, uint64_t, BY_VAL, 0);
+
@@ -0,0 +1,17 @@
+#ifndef FVU64_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_GROWTH vec_growth_fixed
+#define VEC_SETTINGS_GROWTH_PARAM 100
+
+#include "vec.h"
+VEC_INCLUDE(FVu64, fvu64, uint64_t, BY_VAL);
+
+#undef VEC_SETTINGS_GROWTH_PARAM
+#undef VEC_SETTINGS_GROWTH
+
+#define FVU64_H
+#endif
+
@@ -0,0 +1,8 @@
+#include "gstr.h"
+
+#define VEC_SETTINGS_DEFAULT_SIZE STR_DEFAULT_SIZE
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#define VEC_SETTINGS_STRUCT_ITEMS s
+
+VEC_GAP_IMPLEMENT(GStr, gstr, char, Str, str);
+
@@ -0,0 +1,21 @@
+#ifndef GSTR_H
+
+#include "str.h"
+
+/* configuration, inclusion and de-configuration of gap buffer, same as Str */
+
+#define VEC_SETTINGS_DEFAULT_SIZE STR_DEFAULT_SIZE
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#define VEC_SETTINGS_STRUCT_ITEMS s
+
+#include "vec.h"
+#include "vec_gap.h"
+VEC_GAP_INCLUDE(GStr, gstr, char, Str);
+
+#undef VEC_SETTINGS_STRUCT_ITEMS
+#undef VEC_SETTINGS_KEEP_ZERO_END
+#undef VEC_SETTINGS_DEFAULT_SIZE
+
+#define GSTR_H
+#endif
+
@@ -0,0 +1,7 @@
+#include "hvu64.h"
+
+#define VEC_SETTINGS_MREMAP_THRESHOLD 0x10000
+#define VEC_SETTINGS_HUGEPAGE_THRESHOLD 0x400000
+
+VEC_IMPLEMENT(HVu64, hvu64, uint64_t, BY_VAL, 0);
+
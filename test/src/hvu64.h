@@ -0,0 +1,17 @@
+#ifndef HVU64_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_MREMAP_THRESHOLD 0x10000
+#define VEC_SETTINGS_HUGEPAGE_THRESHOLD 0x400000
+
+#include "vec.h"
+VEC_INCLUDE(HVu64, hvu64, uint64_t, BY_VAL);
+
+#undef VEC_SETTINGS_MREMAP_THRESHOLD
+#undef VEC_SETTINGS_HUGEPAGE_THRESHOLD
+
+#define HVU64_H
+#endif
+
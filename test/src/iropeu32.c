@@ -0,0 +1,7 @@
+#include "iropeu32.h"
+
+#define VEC_SETTINGS_INLINE_CAP 16
+#define VEC_SETTINGS_ROPE_LEAF 8
+
+VEC_ROPE_IMPLEMENT(IRopeU32, iropeu32, uint32_t, IVu32, ivu32);
+
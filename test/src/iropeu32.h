@@ -0,0 +1,20 @@
+#ifndef IROPEU32_H
+#include <stdint.h>
+
+#include "ivu32.h"
+
+/* configuration, inclusion and de-configuration of rope, same as IVu32 */
+
+#define VEC_SETTINGS_INLINE_CAP 16
+#define VEC_SETTINGS_ROPE_LEAF 8
+
+#include "vec.h"
+#include "vec_rope.h"
+VEC_ROPE_INCLUDE(IRopeU32, iropeu32, uint32_t, IVu32);
+
+#undef VEC_SETTINGS_ROPE_LEAF
+#undef VEC_SETTINGS_INLINE_CAP
+
+#define IROPEU32_H
+#endif
+
@@ -0,0 +1,6 @@
+#include "ivu32.h"
+
+#define VEC_SETTINGS_INLINE_CAP 16
+
+VEC_IMPLEMENT(IVu32, ivu32, uint32_t, BY_VAL, 0);
+
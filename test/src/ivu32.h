@@ -0,0 +1,15 @@
+#ifndef IVU32_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_INLINE_CAP 16
+
+#include "vec.h"
+VEC_INCLUDE(IVu32, ivu32, uint32_t, BY_VAL);
+
+#undef VEC_SETTINGS_INLINE_CAP
+
+#define IVU32_H
+#endif
+
@@ -0,0 +1,6 @@
+#include "lvu32.h"
+
+#define VEC_SETTINGS_SHRINK_LOW 4
+
+VEC_IMPLEMENT(LVu32, lvu32, uint32_t, BY_VAL, 0);
+
@@ -0,0 +1,15 @@
+#ifndef LVU32_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_SHRINK_LOW 4
+
+#include "vec.h"
+VEC_INCLUDE(LVu32, lvu32, uint32_t, BY_VAL);
+
+#undef VEC_SETTINGS_SHRINK_LOW
+
+#define LVU32_H
+#endif
+
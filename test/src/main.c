@@ -1,10 +1,35 @@
 #include "unity.h"
 #include "unity_internals.h"
 #include "vu8.h"
+#include "vu16.h"
+#include "vu32.h"
+#include "vu64.h"
 #include "rvu8.h"
 #include "str.h"
 #include "rvstr.h"
 #include "vstr.h"
+#include "srvstr.h"
+#include "fvu64.h"
+#include "ustr.h"
+#include "mvu64.h"
+#include "ivu32.h"
+#include "avi16.h"
+#include "hvu64.h"
+#include "lvu32.h"
+#include "svu32.h"
+#include "ru32.h"
+#include "rstr.h"
+#include "qvu32.h"
+#include "qu64.h"
+#include "mu64.h"
+#include "sgu32.h"
+#include "sgstr.h"
+#include "gstr.h"
+#include "ropestr.h"
+#include "iropeu32.h"
+
+#include <pthread.h>
+#include <sched.h>
 
 void setUp(void) {
     // set stuff up here
@@ -14,6 +39,35 @@ void tearDown(void) {
     // clean stuff up here
 }
 
+typedef struct CountingAllocator {
+    size_t allocs;
+    size_t reallocs;
+    size_t frees;
+    size_t bytes;
+} CountingAllocator;
+
+static void *counting_alloc(void *user, size_t size) {
+    CountingAllocator *counter = user;
+    counter->allocs++;
+    counter->bytes += size;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *user, void *ptr, size_t size_old, size_t size_new) {
+    CountingAllocator *counter = user;
+    counter->reallocs++;
+    counter->bytes += size_new;
+    counter->bytes -= size_old;
+    return realloc(ptr, size_new);
+}
+
+static void counting_free(void *user, void *ptr, size_t size) {
+    CountingAllocator *counter = user;
+    counter->frees++;
+    counter->bytes -= size;
+    free(ptr);
+}
+
 void test_vu8_stack_lifetime(void) {
     Vu8 v = (Vu8){ .last = 16, .items = (unsigned char []){0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}};
     TEST_ASSERT_EQUAL(16, vu8_length(&v));
@@ -154,6 +208,222 @@ void test_vu8_reverse(void)
     vu8_free(&v);
 }
 
+void test_vu8_reverse_slice(void)
+{
+    Vu8 v = {0};
+    /* long enough to go through the block kernels and the middle */
+    for(size_t n = 0; n < 200; n += 7) {
+        vu8_clear(&v);
+        for(size_t i = 0; i < n + 6; i++) TEST_ASSERT_EQUAL(0, vu8_push_back(&v, i));
+        vu8_reverse_slice(&v, 3, n);
+        for(size_t i = 0; i < 3; i++) TEST_ASSERT_EQUAL(i, vu8_get_at(&v, i));
+        for(size_t i = 0; i < n; i++) TEST_ASSERT_EQUAL(3 + n - 1 - i, vu8_get_at(&v, 3 + i));
+        for(size_t i = n + 3; i < n + 6; i++) TEST_ASSERT_EQUAL(i, vu8_get_at(&v, i));
+    }
+    vu8_free(&v);
+}
+
+void test_vu8_push_n(void)
+{
+    Vu8 v = {0};
+    uint8_t buf[] = {1, 2, 3, 4, 5};
+    TEST_ASSERT_EQUAL(0, vu8_push_back_n(&v, buf, 5));
+    TEST_ASSERT_EQUAL(0, vu8_push_at_n(&v, 2, buf, 2));
+    TEST_ASSERT_EQUAL(0, vu8_push_front_n(&v, buf + 3, 2));
+    /* the room left by popping the front gets reused */
+    vu8_pop_front(&v, 0);
+    vu8_pop_front(&v, 0);
+    size_t cap = vu8_capacity(&v);
+    TEST_ASSERT_EQUAL(0, vu8_push_front_n(&v, buf, 2));
+    TEST_ASSERT_EQUAL(cap, vu8_capacity(&v));
+    TEST_ASSERT_EQUAL(0, vu8_push_back_n(&v, 0, 0));
+    uint8_t expect[] = {1, 2, 1, 2, 1, 2, 3, 4, 5};
+    TEST_ASSERT_EQUAL(sizeof(expect), vu8_length(&v));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, vu8_iter_begin(&v), sizeof(expect));
+    vu8_free(&v);
+}
+
+void test_vu8_copy(void)
+{
+    Vu8 a = {0}, b = {0};
+    TEST_ASSERT_EQUAL(0, vu8_push_back(&a, 1));
+    TEST_ASSERT_EQUAL(0, vu8_push_back(&a, 2));
+    TEST_ASSERT_EQUAL(0, vu8_push_front(&a, 0));
+    /* the copy starts at the first item, not at the room in front of it */
+    TEST_ASSERT_EQUAL(0, vu8_copy(&b, &a));
+    uint8_t expect[] = {0, 1, 2};
+    TEST_ASSERT_EQUAL(sizeof(expect), vu8_length(&b));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, vu8_iter_begin(&b), sizeof(expect));
+    vu8_free(&a);
+    vu8_free(&b);
+}
+
+void test_vu8_move(void)
+{
+    Vu8 a = {0}, b = {0};
+    for(size_t i = 0; i < 10; i++) TEST_ASSERT_EQUAL(0, vu8_push_back(&a, i));
+    for(size_t i = 0; i < 3; i++) TEST_ASSERT_EQUAL(0, vu8_push_back(&b, 100 + i));
+    uint8_t *items = a.items;
+    vu8_swap_vectors(&a, &b);
+    TEST_ASSERT_EQUAL_PTR(items, b.items);
+    TEST_ASSERT_EQUAL(3, vu8_length(&a));
+    vu8_move(&a, &b);
+    TEST_ASSERT_EQUAL_PTR(items, a.items);
+    TEST_ASSERT_EQUAL(0, vu8_capacity(&b));
+    /* the room in front gets closed when detaching */
+    vu8_pop_front(&a, 0);
+    size_t len = 0;
+    uint8_t *detached = vu8_detach(&a, &len);
+    TEST_ASSERT_EQUAL_PTR(items, detached);
+    TEST_ASSERT_EQUAL(9, len);
+    TEST_ASSERT_EQUAL(0, vu8_capacity(&a));
+    for(size_t i = 0; i < len; i++) TEST_ASSERT_EQUAL(i + 1, detached[i]);
+    TEST_ASSERT_EQUAL(0, vu8_adopt(&b, detached, len, len + 1));
+    TEST_ASSERT_EQUAL_PTR(items, b.items);
+    TEST_ASSERT_EQUAL(9, vu8_length(&b));
+    TEST_ASSERT_EQUAL(0, vu8_push_back(&b, 10));
+    TEST_ASSERT_EQUAL(10, vu8_get_back(&b));
+    /* nothing to hand out, the memory gets freed instead */
+    vu8_clear(&b);
+    TEST_ASSERT_NULL(vu8_detach(&b, &len));
+    TEST_ASSERT_EQUAL(0, len);
+    TEST_ASSERT_EQUAL(0, vu8_capacity(&b));
+    vu8_free(&a);
+    vu8_free(&b);
+}
+
+static int vu8_is_odd(const uint8_t *item, void *ctx)
+{
+    (*(size_t *)ctx)++;
+    return *item & 1;
+}
+
+void test_vu8_retain(void)
+{
+    Vu8 v = {0};
+    for(size_t i = 0; i < 20; i++) TEST_ASSERT_EQUAL(0, vu8_push_back(&v, i));
+    vu8_pop_front(&v, 0);
+    size_t calls = 0;
+    TEST_ASSERT_EQUAL(9, vu8_retain(&v, vu8_is_odd, &calls));
+    TEST_ASSERT_EQUAL(19, calls);
+    uint8_t expect[] = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
+    TEST_ASSERT_EQUAL(sizeof(expect), vu8_length(&v));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, vu8_iter_begin(&v), sizeof(expect));
+    /* 1 3 | 5 7 9 | 11 13 15 17 19 */
+    vu8_erase_range(&v, 2, 3);
+    vu8_erase_range(&v, 0, 1);
+    vu8_erase_range(&v, 5, 1);
+    vu8_erase_range(&v, 2, 0);
+    uint8_t expect2[] = {3, 11, 13, 15, 17};
+    TEST_ASSERT_EQUAL(sizeof(expect2), vu8_length(&v));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect2, vu8_iter_begin(&v), sizeof(expect2));
+    TEST_ASSERT_EQUAL(0, vu8_retain(&v, vu8_is_odd, &calls));
+    vu8_erase_range(&v, 0, 5);
+    TEST_ASSERT_EQUAL(0, vu8_length(&v));
+    vu8_free(&v);
+}
+
+void test_vu8_swap_remove(void)
+{
+    Vu8 v = {0};
+    for(size_t i = 0; i < 10; i++) TEST_ASSERT_EQUAL(0, vu8_push_back(&v, i));
+    uint8_t val = 0;
+    vu8_swap_remove(&v, 2, &val);
+    TEST_ASSERT_EQUAL(2, val);
+    vu8_swap_remove(&v, 8, &val);
+    TEST_ASSERT_EQUAL(8, val);
+    /* 0 1 9 3 4 5 6 7 */
+    size_t indices[] = {0, 3, 6, 7};
+    vu8_swap_remove_n(&v, indices, 4);
+    uint8_t expect[] = {4, 1, 9, 5};
+    TEST_ASSERT_EQUAL(sizeof(expect), vu8_length(&v));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, vu8_iter_begin(&v), sizeof(expect));
+    size_t all[] = {0, 1, 2, 3};
+    vu8_swap_remove_n(&v, all, 4);
+    TEST_ASSERT_EQUAL(0, vu8_length(&v));
+    vu8_free(&v);
+}
+
+void test_vu8_slices(void)
+{
+    Vu8 a = {0}, b = {0};
+    for(size_t i = 0; i < 10; i++) TEST_ASSERT_EQUAL(0, vu8_push_back(&a, i));
+    for(size_t i = 0; i < 3; i++) TEST_ASSERT_EQUAL(0, vu8_push_back(&b, 100 + i));
+    /* 100 101 0 1 2 100 101 102 3 4 5 6 7 8 9 100 101 102 */
+    TEST_ASSERT_EQUAL(0, vu8_extend_back(&a, &b, 5));
+    TEST_ASSERT_EQUAL(0, vu8_extend_at(&a, 3, &b, 3));
+    TEST_ASSERT_EQUAL(0, vu8_extend_front(&a, &b, 2));
+    uint8_t expect[] = {100, 101, 0, 1, 2, 100, 101, 102, 3, 4, 5, 6, 7, 8, 9, 100, 101, 102};
+    TEST_ASSERT_EQUAL(sizeof(expect), vu8_length(&a));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, vu8_iter_begin(&a), sizeof(expect));
+    /* move 100 101 102 out of the middle, then the front and the back */
+    vu8_clear(&b);
+    TEST_ASSERT_EQUAL(0, vu8_cut_at(&a, 5, 3, &b));
+    TEST_ASSERT_EQUAL(0, vu8_cut_front(&a, &b, 2));
+    TEST_ASSERT_EQUAL(0, vu8_cut_back(&a, &b, 3));
+    TEST_ASSERT_EQUAL(10, vu8_length(&a));
+    for(size_t i = 0; i < 10; i++) TEST_ASSERT_EQUAL(i, vu8_get_at(&a, i));
+    uint8_t moved[] = {100, 101, 102, 100, 101, 100, 101, 102};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(moved, vu8_iter_begin(&b), sizeof(moved));
+    /* overwrite, growing past the end */
+    TEST_ASSERT_EQUAL(0, vu8_paste_at(&a, 8, &b, 3));
+    TEST_ASSERT_EQUAL(11, vu8_length(&a));
+    TEST_ASSERT_EQUAL(102, vu8_get_at(&a, 10));
+    TEST_ASSERT_EQUAL(0, vu8_paste_front(&a, &b, 1));
+    TEST_ASSERT_EQUAL(0, vu8_paste_back(&a, &b, 2));
+    uint8_t pasted[] = {100, 1, 2, 3, 4, 5, 6, 7, 100, 100, 101};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(pasted, vu8_iter_begin(&a), sizeof(pasted));
+    /* copies stay */
+    vu8_clear(&b);
+    TEST_ASSERT_EQUAL(0, vu8_cat_front(&a, &b, 2));
+    TEST_ASSERT_EQUAL(0, vu8_cat_at(&a, 3, 2, &b));
+    TEST_ASSERT_EQUAL(0, vu8_cat_back(&a, &b, 1));
+    uint8_t copied[] = {100, 1, 3, 4, 101};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(copied, vu8_iter_begin(&b), sizeof(copied));
+    TEST_ASSERT_EQUAL(11, vu8_length(&a));
+    vu8_free(&a);
+    vu8_free(&b);
+}
+
+void test_vu8_allocator(void)
+{
+    CountingAllocator counter = {0};
+    VecAllocator allocator = {counting_alloc, counting_realloc, counting_free, &counter};
+    Vu8 v = { .allocator = &allocator };
+    for(size_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(0, vu8_push_back(&v, i));
+    }
+    TEST_ASSERT_NOT_EQUAL(0, counter.reallocs);
+    TEST_ASSERT_EQUAL(vu8_reserved(&v), counter.bytes);
+    for(size_t i = 0; i < 990; i++) {
+        vu8_pop_back(&v, 0);
+    }
+    TEST_ASSERT_EQUAL(0, vu8_shrink(&v));
+    TEST_ASSERT_EQUAL(vu8_reserved(&v), counter.bytes);
+    vu8_free(&v);
+    TEST_ASSERT_EQUAL(0, counter.bytes);
+    TEST_ASSERT_EQUAL(&allocator, v.allocator);
+}
+
+void test_vu8_shrink_to_fit(void)
+{
+    Vu8 v = {0};
+    for(size_t i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(0, vu8_push_front(&v, i));
+    }
+    vu8_pop_front(&v, 0);
+    TEST_ASSERT_EQUAL(8, vu8_capacity(&v));
+    TEST_ASSERT_EQUAL(0, vu8_shrink_to_fit(&v));
+    TEST_ASSERT_EQUAL(4, vu8_capacity(&v));
+    TEST_ASSERT_EQUAL(3, vu8_get_front(&v));
+    TEST_ASSERT_EQUAL(0, vu8_get_back(&v));
+    vu8_clear(&v);
+    TEST_ASSERT_EQUAL(0, vu8_shrink_to_fit(&v));
+    TEST_ASSERT_EQUAL(0, vu8_capacity(&v));
+    TEST_ASSERT_EQUAL(0, vu8_reserved(&v));
+    vu8_free(&v);
+}
+
 void test_vu8(void) {
     RUN_TEST(test_vu8_stack_lifetime);
     RUN_TEST(test_vu8_push_back);
@@ -161,6 +431,797 @@ void test_vu8(void) {
     RUN_TEST(test_vu8_push_at);
     RUN_TEST(test_vu8_pop_at);
     RUN_TEST(test_vu8_reverse);
+    RUN_TEST(test_vu8_reverse_slice);
+    RUN_TEST(test_vu8_slices);
+    RUN_TEST(test_vu8_push_n);
+    RUN_TEST(test_vu8_copy);
+    RUN_TEST(test_vu8_move);
+    RUN_TEST(test_vu8_retain);
+    RUN_TEST(test_vu8_swap_remove);
+    RUN_TEST(test_vu8_allocator);
+    RUN_TEST(test_vu8_shrink_to_fit);
+}
+
+void test_growth_policies(void)
+{
+    TEST_ASSERT_EQUAL(16, vec_growth_double(4, 9, 1, 0));
+    TEST_ASSERT_EQUAL(11, vec_growth_1_5(4, 8, 1, 0));
+    TEST_ASSERT_EQUAL(7, vec_growth_golden(4, 7, 1, 0));
+    TEST_ASSERT_EQUAL(68, vec_growth_fixed(4, 5, 1, 0));
+    TEST_ASSERT_EQUAL(24, vec_growth_fixed(4, 21, 1, 10));
+    TEST_ASSERT_EQUAL(1024, vec_growth_page(4, 5, 4, 0));
+    TEST_ASSERT_EQUAL(2048, vec_growth_page(4, 1025, 4, 0));
+}
+
+void test_fvu64_growth(void)
+{
+    FVu64 v = {0};
+    for(size_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(0, fvu64_push_back(&v, i));
+    }
+    TEST_ASSERT_EQUAL(1004, fvu64_capacity(&v));
+    for(size_t i = 0; i < 750; i++) {
+        fvu64_pop_back(&v, 0);
+    }
+    TEST_ASSERT_EQUAL(0, fvu64_shrink(&v));
+    TEST_ASSERT_EQUAL(304, fvu64_capacity(&v));
+    TEST_ASSERT_EQUAL(249, fvu64_get_back(&v));
+    fvu64_free(&v);
+}
+
+void test_mvu64_mremap(void)
+{
+    MVu64 v = {0};
+    size_t n = 0x100000;
+    for(size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL(0, mvu64_push_back(&v, i));
+    }
+    for(size_t i = 0; i < n; i += 0x1000) {
+        TEST_ASSERT_EQUAL(i, mvu64_get_at(&v, i));
+    }
+    /* capacity regained after a shrink is zero */
+    TEST_ASSERT_EQUAL(0, mvu64_resize(&v, 0x1001));
+    size_t cap = mvu64_capacity(&v);
+    TEST_ASSERT_EQUAL(0, mvu64_resize(&v, n));
+    TEST_ASSERT_EQUAL(0x1000, mvu64_get_at(&v, 0x1000));
+    TEST_ASSERT_EQUAL(0, mvu64_get_at(&v, cap));
+    TEST_ASSERT_EQUAL(0, mvu64_get_at(&v, n - 1));
+    /* back below the threshold */
+    TEST_ASSERT_EQUAL(0, mvu64_resize(&v, 100));
+    TEST_ASSERT_EQUAL(99, mvu64_get_back(&v));
+    mvu64_free(&v);
+}
+
+void test_growth(void) {
+    RUN_TEST(test_growth_policies);
+    RUN_TEST(test_fvu64_growth);
+    RUN_TEST(test_mvu64_mremap);
+}
+
+void test_ivu32_inline(void)
+{
+    CountingAllocator counter = {0};
+    VecAllocator allocator = {counting_alloc, counting_realloc, counting_free, &counter};
+    IVu32 v = { .allocator = &allocator };
+    for(size_t i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL(0, ivu32_push_back(&v, i));
+    }
+    TEST_ASSERT_EQUAL(0, counter.allocs + counter.reallocs);
+    TEST_ASSERT_EQUAL(0, ivu32_reserved(&v));
+    TEST_ASSERT_EQUAL_PTR(v.inline_items, v.items);
+    /* spill to the heap */
+    TEST_ASSERT_EQUAL(0, ivu32_push_back(&v, 16));
+    TEST_ASSERT_EQUAL(1, counter.allocs);
+    TEST_ASSERT_EQUAL(ivu32_reserved(&v), counter.bytes);
+    for(size_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(0, ivu32_push_front(&v, i));
+    }
+    for(size_t i = 0; i < 110; i++) {
+        ivu32_pop_front(&v, 0);
+    }
+    /* and back */
+    TEST_ASSERT_EQUAL(0, ivu32_shrink(&v));
+    TEST_ASSERT_EQUAL(0, counter.bytes);
+    TEST_ASSERT_EQUAL_PTR(v.inline_items, v.items);
+    TEST_ASSERT_EQUAL(7, ivu32_length(&v));
+    for(size_t i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL(i + 10, ivu32_get_at(&v, i));
+    }
+    ivu32_free(&v);
+    TEST_ASSERT_EQUAL(0, counter.bytes);
+    TEST_ASSERT_EQUAL(0, ivu32_capacity(&v));
+}
+
+void test_ivu32_move(void)
+{
+    IVu32 a = {0}, b = {0};
+    for(size_t i = 0; i < 4; i++) TEST_ASSERT_EQUAL(0, ivu32_push_back(&a, i));
+    /* inline items can't be handed over, they follow the struct */
+    ivu32_move(&b, &a);
+    TEST_ASSERT_EQUAL_PTR(b.inline_items, b.items);
+    TEST_ASSERT_EQUAL(4, ivu32_length(&b));
+    TEST_ASSERT_EQUAL(3, ivu32_get_back(&b));
+    TEST_ASSERT_EQUAL(0, ivu32_length(&a));
+    ivu32_swap_vectors(&a, &b);
+    TEST_ASSERT_EQUAL_PTR(a.inline_items, a.items);
+    TEST_ASSERT_EQUAL(4, ivu32_length(&a));
+    size_t len = 0;
+    uint32_t *items = ivu32_detach(&a, &len);
+    TEST_ASSERT_NOT_NULL(items);
+    TEST_ASSERT_EQUAL(4, len);
+    TEST_ASSERT_EQUAL(2, items[2]);
+    vec_free(items);
+    ivu32_free(&a);
+    ivu32_free(&b);
+}
+
+void test_ivu32_adopt(void)
+{
+    /* smaller than the inline capacity, so it gets copied instead of taken over */
+    uint32_t *small = vec_malloc(sizeof(uint32_t) * 8);
+    TEST_ASSERT_NOT_NULL(small);
+    small[0] = 100;
+    small[1] = 101;
+    IVu32 v = {0};
+    TEST_ASSERT_EQUAL(0, ivu32_adopt(&v, small, 2, 8));
+    for(size_t i = 0; i < 7; i++) TEST_ASSERT_EQUAL(0, ivu32_push_back(&v, i));
+    TEST_ASSERT_EQUAL(9, ivu32_length(&v));
+    TEST_ASSERT_EQUAL(100, ivu32_get_at(&v, 0));
+    TEST_ASSERT_EQUAL(101, ivu32_get_at(&v, 1));
+    TEST_ASSERT_EQUAL(6, ivu32_get_back(&v));
+    /* larger ones are taken over */
+    uint32_t *large = vec_malloc(sizeof(uint32_t) * 32);
+    TEST_ASSERT_NOT_NULL(large);
+    large[0] = 200;
+    TEST_ASSERT_EQUAL(0, ivu32_adopt(&v, large, 1, 32));
+    TEST_ASSERT_EQUAL_PTR(large, v.items);
+    for(size_t i = 0; i < 40; i++) TEST_ASSERT_EQUAL(0, ivu32_push_back(&v, i));
+    TEST_ASSERT_EQUAL(200, ivu32_get_at(&v, 0));
+    TEST_ASSERT_EQUAL(39, ivu32_get_back(&v));
+    ivu32_free(&v);
+}
+
+void test_ivu32(void) {
+    RUN_TEST(test_ivu32_inline);
+    RUN_TEST(test_ivu32_move);
+    RUN_TEST(test_ivu32_adopt);
+}
+
+void test_avi16_align(void)
+{
+    AVi16 v = {0};
+    AVi16 copy = {0};
+    for(size_t i = 0; i < 5000; i++) {
+        TEST_ASSERT_EQUAL(0, avi16_push_back(&v, (int16_t)i));
+        TEST_ASSERT_EQUAL(0, (uintptr_t)v.items % 64);
+    }
+    for(size_t i = 0; i < 4990; i++) {
+        avi16_pop_back(&v, 0);
+    }
+    TEST_ASSERT_EQUAL(0, avi16_shrink(&v));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)v.items % 64);
+    TEST_ASSERT_EQUAL(0, avi16_copy(&copy, &v));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)copy.items % 64);
+    TEST_ASSERT_EQUAL(9, avi16_get_back(&copy));
+    avi16_free(&copy);
+    avi16_free(&v);
+}
+
+void test_hvu64_hugepage(void)
+{
+    HVu64 v = {0};
+    size_t n = 0x200000;
+    for(size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL(0, hvu64_push_back(&v, i));
+        if(hvu64_capacity(&v) * sizeof(uint64_t) >= 0x400000) {
+            TEST_ASSERT_EQUAL(0, (uintptr_t)v.items % ((size_t)1 << 21));
+        }
+    }
+    for(size_t i = 0; i < n; i += 0x1000) {
+        TEST_ASSERT_EQUAL(i, hvu64_get_at(&v, i));
+    }
+    /* capacity regained after a shrink is zero */
+    TEST_ASSERT_EQUAL(0, hvu64_resize(&v, 0x80001));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)v.items % ((size_t)1 << 21));
+    size_t cap = hvu64_capacity(&v);
+    TEST_ASSERT_EQUAL(0, hvu64_resize(&v, n));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)v.items % ((size_t)1 << 21));
+    TEST_ASSERT_EQUAL(0x80000, hvu64_get_at(&v, 0x80000));
+    TEST_ASSERT_EQUAL(0, hvu64_get_at(&v, cap));
+    TEST_ASSERT_EQUAL(0, hvu64_get_at(&v, n - 1));
+    /* back below both thresholds */
+    TEST_ASSERT_EQUAL(0, hvu64_resize(&v, 100));
+    TEST_ASSERT_EQUAL(99, hvu64_get_back(&v));
+    hvu64_free(&v);
+}
+
+void test_lvu32_shrink_low(void)
+{
+    LVu32 v = {0};
+    for(size_t i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL(0, lvu32_push_back(&v, i));
+    }
+    TEST_ASSERT_EQUAL(64, lvu32_capacity(&v));
+    /* hovering around a power of two doesn't reallocate */
+    for(size_t r = 0; r < 10; r++) {
+        for(size_t i = 0; i < 40; i++) lvu32_pop_back(&v, 0);
+        TEST_ASSERT_EQUAL(0, lvu32_shrink(&v));
+        TEST_ASSERT_EQUAL(64, lvu32_capacity(&v));
+        for(size_t i = 0; i < 40; i++) TEST_ASSERT_EQUAL(0, lvu32_push_back(&v, i));
+    }
+    /* below the low-water mark of cap/4 */
+    TEST_ASSERT_EQUAL(0, lvu32_resize(&v, 15));
+    TEST_ASSERT_EQUAL(16, lvu32_capacity(&v));
+    TEST_ASSERT_EQUAL(14, lvu32_get_back(&v));
+    TEST_ASSERT_EQUAL(0, lvu32_shrink_to_fit(&v));
+    TEST_ASSERT_EQUAL(15, lvu32_capacity(&v));
+    TEST_ASSERT_EQUAL(0, lvu32_resize(&v, 0));
+    TEST_ASSERT_EQUAL(0, lvu32_capacity(&v));
+    lvu32_free(&v);
+}
+
+void test_svu32_stats(void)
+{
+    SVu32 v = {0};
+    svu32_stats_reset();
+    for(size_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(0, svu32_push_back(&v, i));
+    }
+    const VecStats *stats = svu32_stats();
+    TEST_ASSERT_EQUAL(1, stats->allocs);
+    TEST_ASSERT_EQUAL(5, stats->reallocs);
+    TEST_ASSERT_EQUAL(128, stats->peak_cap);
+    TEST_ASSERT_EQUAL(0, stats->memmoves);
+    /* inserting in the middle shifts the tail */
+    TEST_ASSERT_EQUAL(0, svu32_push_at(&v, 50, 0));
+    TEST_ASSERT_EQUAL(1, stats->memmoves);
+    TEST_ASSERT_EQUAL(50 * sizeof(uint32_t), stats->bytes_moved);
+    svu32_pop_at(&v, 50, 0);
+    TEST_ASSERT_EQUAL(2, stats->memmoves);
+    TEST_ASSERT_EQUAL(0, svu32_resize(&v, 10));
+    TEST_ASSERT_EQUAL(1, stats->shrinks);
+    svu32_free(&v);
+    TEST_ASSERT_EQUAL(1, stats->frees);
+    FILE *file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+    svu32_stats_dump(file);
+    TEST_ASSERT_NOT_EQUAL(0, ftell(file));
+    fclose(file);
+    svu32_stats_reset();
+    TEST_ASSERT_EQUAL(0, stats->allocs);
+    TEST_ASSERT_EQUAL(0, stats->peak_cap);
+}
+
+void test_svu32_push_front(void)
+{
+    SVu32 v = {0};
+    svu32_stats_reset();
+    for(size_t i = 0; i < 100000; i++) {
+        TEST_ASSERT_EQUAL(0, svu32_push_front(&v, i));
+    }
+    /* items are only shifted when the room in front ran out */
+    TEST_ASSERT_LESS_THAN(64, svu32_stats()->memmoves);
+    TEST_ASSERT_LESS_THAN(100000 * 4 * sizeof(uint32_t), svu32_stats()->bytes_moved);
+    for(size_t i = 0; i < 100000; i++) {
+        TEST_ASSERT_EQUAL(99999 - i, svu32_get_at(&v, i));
+    }
+    svu32_free(&v);
+}
+
+void test_ru32_queue(void)
+{
+    Ru32 q = {0};
+    /* a steady queue never grows past its peak length */
+    for(size_t i = 0; i < 10000; i++) {
+        TEST_ASSERT_EQUAL(0, ru32_push_back(&q, i));
+        if(i >= 5) {
+            uint32_t val = 0;
+            ru32_pop_front(&q, &val);
+            TEST_ASSERT_EQUAL(i - 5, val);
+        }
+    }
+    TEST_ASSERT_EQUAL(5, ru32_length(&q));
+    TEST_ASSERT_EQUAL(8, ru32_capacity(&q));
+    /* both ends */
+    TEST_ASSERT_EQUAL(0, ru32_push_front(&q, 1));
+    TEST_ASSERT_EQUAL(0, ru32_push_front(&q, 0));
+    TEST_ASSERT_EQUAL(0, ru32_get_front(&q));
+    TEST_ASSERT_EQUAL(9999, ru32_get_back(&q));
+    uint32_t val = 0;
+    ru32_pop_back(&q, &val);
+    TEST_ASSERT_EQUAL(9999, val);
+    TEST_ASSERT_EQUAL(9998, ru32_get_back(&q));
+    ru32_free(&q);
+}
+
+void test_ru32_segments(void)
+{
+    Ru32 q = {0};
+    for(size_t i = 0; i < 6; i++) TEST_ASSERT_EQUAL(0, ru32_push_back(&q, i));
+    for(size_t i = 0; i < 5; i++) ru32_pop_front(&q, 0);
+    for(size_t i = 6; i < 12; i++) TEST_ASSERT_EQUAL(0, ru32_push_back(&q, i));
+    /* 5..11 wrapped around the end of 8 slots */
+    uint32_t *seg1, *seg2;
+    size_t len1, len2;
+    ru32_segments(&q, &seg1, &len1, &seg2, &len2);
+    TEST_ASSERT_EQUAL(8, ru32_capacity(&q));
+    TEST_ASSERT_EQUAL(3, len1);
+    TEST_ASSERT_EQUAL(4, len2);
+    TEST_ASSERT_EQUAL(5, seg1[0]);
+    TEST_ASSERT_EQUAL(8, seg2[0]);
+    /* growth unwraps */
+    TEST_ASSERT_EQUAL(0, ru32_reserve(&q, 9));
+    ru32_segments(&q, &seg1, &len1, &seg2, &len2);
+    TEST_ASSERT_EQUAL(7, len1);
+    TEST_ASSERT_EQUAL(0, len2);
+    for(size_t i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL(i + 5, seg1[i]);
+        TEST_ASSERT_EQUAL(i + 5, ru32_get_at(&q, i));
+    }
+    ru32_free(&q);
+}
+
+void test_rstr_deque(void)
+{
+    RStr q = {0};
+    for(size_t i = 0; i < 1000; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        if(i % 2) {
+            TEST_ASSERT_EQUAL(0, rstr_push_back(&q, str));
+        } else {
+            TEST_ASSERT_EQUAL(0, rstr_push_front(&q, str));
+        }
+        if(i % 5 == 4) rstr_pop_front(&q, 0);
+    }
+    TEST_ASSERT_EQUAL(800, rstr_length(&q));
+    TEST_ASSERT_EQUAL(999, atoi(rstr_get_back(&q).s));
+    rstr_free(&q);
+}
+
+void test_sgu32_stable(void)
+{
+    Sgu32 v = {0};
+    TEST_ASSERT_EQUAL(0, sgu32_push_back(&v, 0));
+    uint32_t *first = sgu32_iter_at(&v, 0);
+    for(size_t i = 1; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(0, sgu32_push_back(&v, i));
+    }
+    /* growing never moved the first item */
+    TEST_ASSERT_EQUAL_PTR(first, sgu32_iter_at(&v, 0));
+    TEST_ASSERT_EQUAL(1000, sgu32_length(&v));
+    TEST_ASSERT_GREATER_OR_EQUAL(1000, sgu32_capacity(&v));
+    for(size_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(i, sgu32_get_at(&v, i));
+    }
+    uint32_t val = 0;
+    sgu32_pop_back(&v, &val);
+    TEST_ASSERT_EQUAL(999, val);
+    sgu32_set_at(&v, 3, 333);
+    TEST_ASSERT_EQUAL(333, sgu32_get_at(&v, 3));
+    sgu32_free(&v);
+    TEST_ASSERT_EQUAL(0, sgu32_capacity(&v));
+}
+
+void test_sgu32_chunks(void)
+{
+    Sgu32 v = {0};
+    TEST_ASSERT_EQUAL(0, sgu32_chunks(&v));
+    for(size_t i = 0; i < 13; i++) {
+        TEST_ASSERT_EQUAL(0, sgu32_push_back(&v, i));
+    }
+    /* chunks of 4, 8 and 16 items */
+    TEST_ASSERT_EQUAL(3, sgu32_chunks(&v));
+    size_t expect[] = {4, 8, 1};
+    uint32_t index = 0;
+    for(size_t k = 0; k < sgu32_chunks(&v); k++) {
+        uint32_t *items;
+        size_t len = sgu32_chunk(&v, k, &items);
+        TEST_ASSERT_EQUAL(expect[k], len);
+        for(size_t i = 0; i < len; i++) {
+            TEST_ASSERT_EQUAL(index++, items[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL(13, index);
+    sgu32_free(&v);
+}
+
+void test_sgstr_reuse(void)
+{
+    SgStr v = {0};
+    for(size_t i = 0; i < 100; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, sgstr_push_back(&v, str));
+        /* popped slots get freed once overwritten */
+        if(i % 3 == 2) sgstr_pop_back(&v, 0);
+    }
+    TEST_ASSERT_EQUAL(67, sgstr_length(&v));
+    TEST_ASSERT_EQUAL(99, atoi(sgstr_get_at(&v, 66).s));
+    sgstr_free(&v);
+}
+
+void test_gstr_edit(void)
+{
+    GStr gap = {0};
+    TEST_ASSERT_EQUAL(0, gstr_insert_n(&gap, "hello world", 11));
+    TEST_ASSERT_EQUAL(11, gstr_cursor(&gap));
+    /* clustered edits in the middle */
+    gstr_move_to(&gap, 5);
+    TEST_ASSERT_EQUAL(0, gstr_insert(&gap, ','));
+    TEST_ASSERT_EQUAL(0, gstr_insert_n(&gap, " dear", 5));
+    gstr_erase_after(&gap, 1);
+    TEST_ASSERT_EQUAL(0, gstr_insert(&gap, '-'));
+    TEST_ASSERT_EQUAL(17, gstr_length(&gap));
+    TEST_ASSERT_EQUAL('-', gstr_get_at(&gap, 11));
+    TEST_ASSERT_EQUAL('w', gstr_get_at(&gap, 12));
+    gstr_move_to(&gap, 0);
+    gstr_erase_after(&gap, 1);
+    TEST_ASSERT_EQUAL(0, gstr_insert(&gap, 'H'));
+    gstr_move_to(&gap, 17);
+    gstr_erase_before(&gap, 5);
+    TEST_ASSERT_EQUAL(0, gstr_insert(&gap, '!'));
+    gstr_move_to(&gap, 3);
+    /* contiguous and zero terminated in place */
+    TEST_ASSERT_EQUAL_STRING("Hello, dear-!", gstr_data(&gap));
+    TEST_ASSERT_EQUAL(13, gstr_cursor(&gap));
+    gstr_free(&gap);
+}
+
+void test_gstr_flatten(void)
+{
+    Str str = {0};
+    TEST_ASSERT_EQUAL(0, str_fmt(&str, "%s", "abcdef"));
+    GStr gap = {0};
+    TEST_ASSERT_EQUAL(0, gstr_load(&gap, &str));
+    gstr_move_to(&gap, 3);
+    for(size_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(0, gstr_insert(&gap, '0' + i % 10));
+    }
+    gstr_erase_before(&gap, 90);
+    TEST_ASSERT_EQUAL(0, gstr_flatten(&gap, &str));
+    TEST_ASSERT_EQUAL(16, str_length(&str));
+    TEST_ASSERT_EQUAL_STRING("abc0123456789def", str_iter_begin(&str));
+    /* the gap is untouched by flattening */
+    TEST_ASSERT_EQUAL(13, gstr_cursor(&gap));
+    gstr_free(&gap);
+    str_free(&str);
+}
+
+void test_ropestr_fmt(void)
+{
+    RopeStr rope = {0};
+    Str expect = {0}, flat = {0};
+    for(size_t i = 0; i < 2000; i++) {
+        TEST_ASSERT_EQUAL(0, ropestr_fmt(&rope, "line %zu\n", i));
+        TEST_ASSERT_EQUAL(0, str_fmt(&expect, "line %zu\n", i));
+    }
+    /* a leaf taken over as is */
+    Str leaf = {0};
+    TEST_ASSERT_EQUAL(0, str_fmt(&leaf, "%s", "the end"));
+    char *s = leaf.s;
+    TEST_ASSERT_EQUAL(0, ropestr_append(&rope, &leaf));
+    TEST_ASSERT_EQUAL(0, str_fmt(&expect, "%s", "the end"));
+    TEST_ASSERT_EQUAL_PTR(s, ropestr_iter_at(&rope, ropestr_length(&rope) - 7));
+    TEST_ASSERT_EQUAL(str_length(&expect), ropestr_length(&rope));
+    TEST_ASSERT_EQUAL('d', ropestr_get_at(&rope, ropestr_length(&rope) - 1));
+    TEST_ASSERT_EQUAL(0, ropestr_flatten(&rope, &flat));
+    TEST_ASSERT_EQUAL_STRING(expect.s, flat.s);
+    ropestr_free(&rope);
+    str_free(&expect);
+    str_free(&flat);
+}
+
+static size_t ropestr_leaves(const RopeStrNode *node)
+{
+    if(!node) return 0;
+    return 1 + ropestr_leaves(node->left) + ropestr_leaves(node->right);
+}
+
+void test_ropestr_append_full(void)
+{
+    RopeStr rope = {0};
+    char chunk[1500];
+    for(size_t i = 0; i < sizeof(chunk); i++) chunk[i] = 'a' + i % 26;
+    for(size_t i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL(0, ropestr_append_n(&rope, chunk, sizeof(chunk)));
+    }
+    /* the room left in the last leaf gets used before new leaves are made */
+    TEST_ASSERT_EQUAL(20 * sizeof(chunk), ropestr_length(&rope));
+    TEST_ASSERT_EQUAL((20 * sizeof(chunk) + 4095) / 4096, ropestr_leaves(rope.root));
+    for(size_t i = 0; i < 20 * sizeof(chunk); i += 777) {
+        TEST_ASSERT_EQUAL(chunk[i % sizeof(chunk)], ropestr_get_at(&rope, i));
+    }
+    ropestr_free(&rope);
+}
+
+void test_iropeu32_inline(void)
+{
+    IRopeU32 rope = {0}, right = {0};
+    IVu32 leaf = {0};
+    uint32_t vals[] = {1, 2, 3};
+    TEST_ASSERT_EQUAL(0, ivu32_push_back_n(&leaf, vals, 3));
+    TEST_ASSERT_EQUAL_PTR(leaf.inline_items, leaf.items);
+    /* the inline items move into the node, reusing the leaf doesn't touch them */
+    TEST_ASSERT_EQUAL(0, iropeu32_append(&rope, &leaf));
+    TEST_ASSERT_EQUAL(0, ivu32_length(&leaf));
+    TEST_ASSERT_EQUAL(0, ivu32_push_back_n(&leaf, (uint32_t []){9, 9, 9, 9, 9}, 5));
+    for(size_t i = 0; i < 3; i++) TEST_ASSERT_EQUAL(i + 1, iropeu32_get_at(&rope, i));
+    /* leaves built from the stack, then split inside one */
+    uint32_t more[20];
+    for(size_t i = 0; i < 20; i++) more[i] = 4 + i;
+    TEST_ASSERT_EQUAL(0, iropeu32_append_n(&rope, more, 20));
+    TEST_ASSERT_EQUAL(0, iropeu32_split(&rope, 10, &right));
+    iropeu32_concat(&rope, &right);
+    TEST_ASSERT_EQUAL(23, iropeu32_length(&rope));
+    for(size_t i = 0; i < 23; i++) TEST_ASSERT_EQUAL(i + 1, iropeu32_get_at(&rope, i));
+    ivu32_free(&leaf);
+    iropeu32_free(&rope);
+    iropeu32_free(&right);
+}
+
+void test_ropestr_edit(void)
+{
+    RopeStr rope = {0}, right = {0};
+    Str flat = {0};
+    TEST_ASSERT_EQUAL(0, ropestr_append_n(&rope, "hello world", 11));
+    /* split inside a leaf and put it back together */
+    TEST_ASSERT_EQUAL(0, ropestr_split(&rope, 5, &right));
+    TEST_ASSERT_EQUAL(5, ropestr_length(&rope));
+    TEST_ASSERT_EQUAL(6, ropestr_length(&right));
+    TEST_ASSERT_EQUAL(0, ropestr_append_n(&rope, ",", 1));
+    ropestr_concat(&rope, &right);
+    TEST_ASSERT_TRUE(ropestr_empty(&right));
+    TEST_ASSERT_EQUAL(0, ropestr_insert_at(&rope, 7, "big ", 4));
+    TEST_ASSERT_EQUAL(0, ropestr_insert_at(&rope, 0, ">> ", 3));
+    TEST_ASSERT_EQUAL(0, ropestr_erase_at(&rope, 8, 1));
+    TEST_ASSERT_EQUAL(0, ropestr_flatten(&rope, &flat));
+    TEST_ASSERT_EQUAL_STRING(">> hello big world", flat.s);
+    TEST_ASSERT_EQUAL(0, ropestr_erase_at(&rope, 0, ropestr_length(&rope)));
+    TEST_ASSERT_TRUE(ropestr_empty(&rope));
+    ropestr_free(&rope);
+    ropestr_free(&right);
+    str_free(&flat);
+}
+
+void test_qvu32_fifo(void)
+{
+    QVu32 q = {0};
+    for(size_t i = 0; i < 10000; i++) {
+        TEST_ASSERT_EQUAL(0, qvu32_push_back(&q, i));
+        if(i >= 5) {
+            uint32_t val = 0;
+            qvu32_pop_front(&q, &val);
+            TEST_ASSERT_EQUAL(i - 5, val);
+        }
+    }
+    /* the dead prefix got reclaimed instead of growing */
+    TEST_ASSERT_EQUAL(5, qvu32_length(&q));
+    TEST_ASSERT_LESS_OR_EQUAL(16, qvu32_capacity(&q));
+    for(size_t i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(9995 + i, qvu32_get_at(&q, i));
+    }
+    qvu32_free(&q);
+}
+
+void test_qu64_single(void)
+{
+    static Qu64 q;
+    TEST_ASSERT_EQUAL(0, qu64_init(&q, 5));
+    TEST_ASSERT_EQUAL(8, qu64_capacity(&q));
+    uint64_t vals[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint64_t out[10] = {0};
+    TEST_ASSERT_EQUAL(6, qu64_push_n(&q, vals, 6));
+    TEST_ASSERT_EQUAL(4, qu64_pop_n(&q, out, 4));
+    /* wraps around the end */
+    TEST_ASSERT_EQUAL(6, qu64_push_n(&q, vals + 4, 6));
+    TEST_ASSERT_EQUAL(8, qu64_length(&q));
+    TEST_ASSERT_FALSE(qu64_try_push(&q, 10));
+    TEST_ASSERT_EQUAL(8, qu64_pop_n(&q, out, 10));
+    TEST_ASSERT_EQUAL(4, out[0]);
+    TEST_ASSERT_EQUAL(5, out[1]);
+    TEST_ASSERT_EQUAL(4, out[2]);
+    TEST_ASSERT_EQUAL(9, out[7]);
+    uint64_t val = 0;
+    TEST_ASSERT_FALSE(qu64_try_pop(&q, &val));
+    TEST_ASSERT_TRUE(qu64_try_push(&q, 42));
+    TEST_ASSERT_TRUE(qu64_try_pop(&q, &val));
+    TEST_ASSERT_EQUAL(42, val);
+    qu64_free(&q);
+}
+
+#define TEST_QU64_N 1000000
+
+static void *test_qu64_producer(void *arg)
+{
+    Qu64 *q = arg;
+    uint64_t vals[7];
+    for(uint64_t i = 0; i < TEST_QU64_N; ) {
+        size_t n = 0;
+        while(n < 7 && i + n < TEST_QU64_N) {
+            vals[n] = i + n;
+            n++;
+        }
+        /* whatever wasn't enqueued is retried */
+        size_t pushed = qu64_push_n(q, vals, n);
+        if(!pushed) sched_yield();
+        i += pushed;
+    }
+    return 0;
+}
+
+void test_qu64_threads(void)
+{
+    static Qu64 q;
+    TEST_ASSERT_EQUAL(0, qu64_init(&q, 64));
+    pthread_t producer;
+    TEST_ASSERT_EQUAL(0, pthread_create(&producer, 0, test_qu64_producer, &q));
+    uint64_t expect = 0;
+    size_t wrong = 0;
+    uint64_t vals[5];
+    while(expect < TEST_QU64_N) {
+        size_t n = qu64_pop_n(&q, vals, 5);
+        if(!n) sched_yield();
+        for(size_t i = 0; i < n; i++) {
+            wrong += (vals[i] != expect);
+            expect = vals[i] + 1;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, pthread_join(producer, 0));
+    TEST_ASSERT_EQUAL(0, wrong);
+    TEST_ASSERT_EQUAL(TEST_QU64_N, expect);
+    TEST_ASSERT_EQUAL(0, qu64_length(&q));
+    qu64_free(&q);
+}
+
+void test_qu64(void) {
+    RUN_TEST(test_qu64_single);
+    RUN_TEST(test_qu64_threads);
+}
+
+void test_mu64_single(void)
+{
+    static Mu64 q;
+    TEST_ASSERT_EQUAL(0, mu64_init(&q, 5));
+    TEST_ASSERT_EQUAL(8, mu64_capacity(&q));
+    uint64_t vals[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint64_t out[10] = {0};
+    TEST_ASSERT_EQUAL(6, mu64_push_n(&q, vals, 6));
+    TEST_ASSERT_EQUAL(4, mu64_pop_n(&q, out, 4));
+    /* wraps around the end */
+    TEST_ASSERT_EQUAL(6, mu64_push_n(&q, vals + 4, 6));
+    TEST_ASSERT_FALSE(mu64_try_push(&q, 10));
+    TEST_ASSERT_EQUAL(8, mu64_pop_n(&q, out, 10));
+    TEST_ASSERT_EQUAL(4, out[0]);
+    TEST_ASSERT_EQUAL(5, out[1]);
+    TEST_ASSERT_EQUAL(4, out[2]);
+    TEST_ASSERT_EQUAL(9, out[7]);
+    uint64_t val = 0;
+    TEST_ASSERT_FALSE(mu64_try_pop(&q, &val));
+    TEST_ASSERT_TRUE(mu64_try_push(&q, 42));
+    TEST_ASSERT_TRUE(mu64_try_pop(&q, &val));
+    TEST_ASSERT_EQUAL(42, val);
+    mu64_free(&q);
+}
+
+#define TEST_MU64_THREADS   3
+#define TEST_MU64_N         100000
+
+typedef struct TestMu64 {
+    Mu64 *q;
+    uint64_t id;
+    uint64_t sum;
+    uint64_t count;
+} TestMu64;
+
+static _Atomic uint64_t test_mu64_consumed;
+
+static void *test_mu64_producer(void *arg)
+{
+    TestMu64 *t = arg;
+    uint64_t vals[3];
+    for(uint64_t i = 0; i < TEST_MU64_N; ) {
+        size_t n = 0;
+        while(n < 3 && i + n < TEST_MU64_N) {
+            vals[n] = (i + n) * TEST_MU64_THREADS + t->id;
+            n++;
+        }
+        size_t pushed = mu64_push_n(t->q, vals, n);
+        if(!pushed) sched_yield();
+        i += pushed;
+    }
+    return 0;
+}
+
+static void *test_mu64_consumer(void *arg)
+{
+    TestMu64 *t = arg;
+    uint64_t vals[4];
+    while(test_mu64_consumed < TEST_MU64_N * TEST_MU64_THREADS) {
+        size_t n = mu64_pop_n(t->q, vals, 4);
+        if(!n) sched_yield();
+        for(size_t i = 0; i < n; i++) t->sum += vals[i];
+        t->count += n;
+        test_mu64_consumed += n;
+    }
+    return 0;
+}
+
+void test_mu64_threads(void)
+{
+    static Mu64 q;
+    TEST_ASSERT_EQUAL(0, mu64_init(&q, 64));
+    pthread_t producers[TEST_MU64_THREADS], consumers[TEST_MU64_THREADS];
+    TestMu64 p[TEST_MU64_THREADS] = {0}, c[TEST_MU64_THREADS] = {0};
+    test_mu64_consumed = 0;
+    for(size_t i = 0; i < TEST_MU64_THREADS; i++) {
+        p[i] = (TestMu64){ .q = &q, .id = i };
+        c[i] = (TestMu64){ .q = &q, .id = i };
+        TEST_ASSERT_EQUAL(0, pthread_create(&producers[i], 0, test_mu64_producer, &p[i]));
+        TEST_ASSERT_EQUAL(0, pthread_create(&consumers[i], 0, test_mu64_consumer, &c[i]));
+    }
+    uint64_t sum = 0, count = 0;
+    for(size_t i = 0; i < TEST_MU64_THREADS; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_join(producers[i], 0));
+        TEST_ASSERT_EQUAL(0, pthread_join(consumers[i], 0));
+        sum += c[i].sum;
+        count += c[i].count;
+    }
+    /* every value 0 .. N*THREADS-1 exactly once */
+    uint64_t total = (uint64_t)TEST_MU64_N * TEST_MU64_THREADS;
+    TEST_ASSERT_EQUAL(total, count);
+    TEST_ASSERT_EQUAL(total * (total - 1) / 2, sum);
+    mu64_free(&q);
+}
+
+void test_mu64(void) {
+    RUN_TEST(test_mu64_single);
+    RUN_TEST(test_mu64_threads);
+}
+
+void test_seg(void) {
+    RUN_TEST(test_sgu32_stable);
+    RUN_TEST(test_sgu32_chunks);
+    RUN_TEST(test_sgstr_reuse);
+}
+
+void test_gap(void) {
+    RUN_TEST(test_gstr_edit);
+    RUN_TEST(test_gstr_flatten);
+}
+
+void test_rope(void) {
+    RUN_TEST(test_ropestr_fmt);
+    RUN_TEST(test_ropestr_edit);
+    RUN_TEST(test_ropestr_append_full);
+    RUN_TEST(test_iropeu32_inline);
+}
+
+void test_qvu32(void) {
+    RUN_TEST(test_qvu32_fifo);
+}
+
+void test_ring(void) {
+    RUN_TEST(test_ru32_queue);
+    RUN_TEST(test_ru32_segments);
+    RUN_TEST(test_rstr_deque);
+}
+
+void test_svu32(void) {
+    RUN_TEST(test_svu32_stats);
+    RUN_TEST(test_svu32_push_front);
+}
+
+void test_lvu32(void) {
+    RUN_TEST(test_lvu32_shrink_low);
+}
+
+void test_hvu64(void) {
+    RUN_TEST(test_hvu64_hugepage);
+}
+
+void test_avi16(void) {
+    RUN_TEST(test_avi16_align);
 }
 
 void test_rvu8_reverse(void)
@@ -176,8 +1237,29 @@ void test_rvu8_reverse(void)
     rvu8_free(&v);
 }
 
+void test_rvu8_allocator(void)
+{
+    CountingAllocator counter = {0};
+    VecAllocator allocator = {counting_alloc, counting_realloc, counting_free, &counter};
+    RVu8 v = { .allocator = &allocator };
+    for(size_t i = 0; i < 100; i++) {
+        unsigned char c = i;
+        TEST_ASSERT_EQUAL(0, rvu8_push_back(&v, &c));
+    }
+    for(size_t i = 0; i < 50; i++) {
+        rvu8_pop_front(&v, 0);
+    }
+    TEST_ASSERT_EQUAL(0, rvu8_shrink(&v));
+    TEST_ASSERT_EQUAL(50, *rvu8_get_front(&v));
+    TEST_ASSERT_EQUAL(rvu8_reserved(&v), counter.bytes);
+    rvu8_free(&v);
+    TEST_ASSERT_EQUAL(0, counter.bytes);
+    TEST_ASSERT_NOT_EQUAL(0, counter.frees);
+}
+
 void test_rvu8(void) {
     RUN_TEST(test_rvu8_reverse);
+    RUN_TEST(test_rvu8_allocator);
 }
 
 void test_rvstr_basic(void) {
@@ -205,6 +1287,45 @@ void test_rvstr_basic(void) {
     rvstr_free(&rvs);
 }
 
+void test_srvstr_basic(void) {
+    SRVStr rvs = {0};
+    size_t n = 10000;
+    Str *front = 0;
+    for(size_t i = 0; i < n; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, srvstr_push_back(&rvs, &str));
+        if(!i) front = srvstr_get_front(&rvs);
+    }
+    /* bodies never move */
+    TEST_ASSERT_EQUAL_PTR(front, srvstr_get_front(&rvs));
+    for(size_t i = 0; i < n / 2; i++) {
+        srvstr_pop_front(&rvs, 0);
+    }
+    TEST_ASSERT_EQUAL(0, srvstr_shrink(&rvs));
+    for(size_t i = 0; i < n / 2; i++) {
+        Str *str = srvstr_get_at(&rvs, i);
+        TEST_ASSERT_EQUAL(i + n / 2, atoi(str->s));
+    }
+    srvstr_free(&rvs);
+    TEST_ASSERT_NULL(rvs.slabs);
+}
+
+void test_ustr_zero_end(void) {
+    UStr str = {0};
+    for(size_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(0, ustr_push_back(&str, 'a' + i % 26));
+        TEST_ASSERT_EQUAL(0, str.s[ustr_length(&str)]);
+    }
+    TEST_ASSERT_EQUAL(1000, strlen(str.s));
+    TEST_ASSERT_EQUAL(0, ustr_push_front(&str, '_'));
+    TEST_ASSERT_EQUAL(0, ustr_push_at(&str, 1, '_'));
+    TEST_ASSERT_EQUAL(1002, strlen(str.s));
+    TEST_ASSERT_EQUAL(0, ustr_reserve(&str, 100000));
+    TEST_ASSERT_EQUAL(1002, strlen(str.s));
+    ustr_free(&str);
+}
+
 void test_vstr_basic(void) {
     VStr vs = {0};
     size_t n = 10000;
@@ -227,12 +1348,393 @@ void test_vstr_basic(void) {
     vstr_free(&vs);
 }
 
+void test_rvstr_deque(void) {
+    RVStr rvs = {0};
+    size_t n = 1000;
+    for(size_t i = 0; i < n; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_front(&rvs, &str));
+        /* pop some again, so that their room gets reused */
+        if(i % 3 == 2) rvstr_pop_front(&rvs, 0);
+    }
+    size_t len = rvstr_length(&rvs);
+    for(size_t i = 0; i < len; i++) {
+        Str *str = rvstr_get_at(&rvs, len - 1 - i);
+        TEST_ASSERT_EQUAL(i + i / 2, atoi(str->s));
+    }
+    rvstr_free(&rvs);
+}
+
+void test_rvstr_cut(void) {
+    RVStr a = {0}, b = {0};
+    for(size_t i = 0; i < 100; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_back(&a, &str));
+    }
+    TEST_ASSERT_EQUAL(0, rvstr_cut_at(&a, 10, 20, &b));
+    TEST_ASSERT_EQUAL(0, rvstr_cut_front(&a, &b, 5));
+    TEST_ASSERT_EQUAL(75, rvstr_length(&a));
+    TEST_ASSERT_EQUAL(30, atoi(rvstr_get_at(&a, 5)->s));
+    TEST_ASSERT_EQUAL(19, atoi(rvstr_get_at(&b, 9)->s));
+    TEST_ASSERT_EQUAL(4, atoi(rvstr_get_back(&b)->s));
+    /* the bodies of the vacated slots are reused */
+    for(size_t i = 0; i < 50; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_back(&a, &str));
+    }
+    TEST_ASSERT_EQUAL(49, atoi(rvstr_get_back(&a)->s));
+    rvstr_free(&a);
+    rvstr_free(&b);
+}
+
+void test_rvstr_emplace(void) {
+    RVStr rvs = {0};
+    for(size_t i = 0; i < 10; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_back(&rvs, &str));
+    }
+    /* the body itself is handed out */
+    Str *at = rvstr_emplace_at(&rvs, 3);
+    TEST_ASSERT_NOT_NULL(at);
+    TEST_ASSERT_EQUAL_PTR(at, rvstr_get_at(&rvs, 3));
+    TEST_ASSERT_EQUAL(0, str_fmt(at, "%s", "emplaced"));
+    Str str = {0};
+    TEST_ASSERT_EQUAL(0, str_fmt(&str, "%s", "pushed"));
+    TEST_ASSERT_EQUAL(0, rvstr_push_at(&rvs, 3, &str));
+    TEST_ASSERT_EQUAL(12, rvstr_length(&rvs));
+    TEST_ASSERT_EQUAL_STRING("2", rvstr_get_at(&rvs, 2)->s);
+    TEST_ASSERT_EQUAL_STRING("pushed", rvstr_get_at(&rvs, 3)->s);
+    TEST_ASSERT_EQUAL_STRING("emplaced", rvstr_get_at(&rvs, 4)->s);
+    TEST_ASSERT_EQUAL_STRING("3", rvstr_get_at(&rvs, 5)->s);
+    TEST_ASSERT_EQUAL_STRING("9", rvstr_get_back(&rvs)->s);
+    rvstr_free(&rvs);
+}
+
+void test_rvstr_adopt(void) {
+    Str *strs = vec_malloc(sizeof(Str) * 10);
+    TEST_ASSERT_NOT_NULL(strs);
+    for(size_t i = 0; i < 10; i++) {
+        strs[i] = (Str){0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&strs[i], "%u", i));
+    }
+    RVStr rvs = {0};
+    TEST_ASSERT_EQUAL(0, rvstr_adopt(&rvs, strs, 10, 10));
+    TEST_ASSERT_EQUAL(10, rvstr_length(&rvs));
+    TEST_ASSERT_EQUAL_STRING("7", rvstr_get_at(&rvs, 7)->s);
+    rvstr_pop_front(&rvs, 0);
+    size_t len = 0;
+    strs = rvstr_detach(&rvs, &len);
+    TEST_ASSERT_EQUAL(9, len);
+    TEST_ASSERT_EQUAL(0, rvstr_length(&rvs));
+    for(size_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL(i + 1, atoi(strs[i].s));
+        str_free(&strs[i]);
+    }
+    vec_free(strs);
+    rvstr_free(&rvs);
+}
+
+static int rstr_keep_even(const Str *str, void *ctx)
+{
+    (void) ctx;
+    return atoi(str->s) % 2 == 0;
+}
+
+void test_rvstr_retain(void) {
+    RVStr rvs = {0};
+    for(size_t i = 0; i < 100; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_back(&rvs, &str));
+    }
+    Str *kept = rvstr_get_at(&rvs, 2);
+    TEST_ASSERT_EQUAL(50, rvstr_retain(&rvs, rstr_keep_even, 0));
+    /* the bodies move along with the items */
+    TEST_ASSERT_EQUAL_PTR(kept, rvstr_get_at(&rvs, 1));
+    rvstr_erase_range(&rvs, 10, 30);
+    TEST_ASSERT_EQUAL(20, rvstr_length(&rvs));
+    TEST_ASSERT_EQUAL(80, atoi(rvstr_get_at(&rvs, 10)->s));
+    /* the removed bodies are recycled */
+    size_t reserved = rvstr_reserved(&rvs);
+    for(size_t i = 0; i < 80; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_back(&rvs, &str));
+    }
+    TEST_ASSERT_EQUAL(reserved, rvstr_reserved(&rvs));
+    rvstr_free(&rvs);
+}
+
+void test_rvstr_swap_remove(void) {
+    RVStr rvs = {0};
+    for(size_t i = 0; i < 10; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_back(&rvs, &str));
+    }
+    Str *back = rvstr_get_back(&rvs);
+    rvstr_swap_remove(&rvs, 4, 0);
+    TEST_ASSERT_EQUAL_PTR(back, rvstr_get_at(&rvs, 4));
+    /* 0 1 2 3 9 5 6 7 8 */
+    size_t indices[] = {1, 2, 7};
+    rvstr_swap_remove_n(&rvs, indices, 3);
+    TEST_ASSERT_EQUAL(6, rvstr_length(&rvs));
+    TEST_ASSERT_EQUAL_STRING("0", rvstr_get_at(&rvs, 0)->s);
+    TEST_ASSERT_EQUAL_STRING("6", rvstr_get_at(&rvs, 1)->s);
+    TEST_ASSERT_EQUAL_STRING("8", rvstr_get_at(&rvs, 2)->s);
+    TEST_ASSERT_EQUAL_STRING("5", rvstr_get_back(&rvs)->s);
+    size_t reserved = rvstr_reserved(&rvs);
+    for(size_t i = 0; i < 4; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, rvstr_push_back(&rvs, &str));
+    }
+    TEST_ASSERT_EQUAL(reserved, rvstr_reserved(&rvs));
+    rvstr_free(&rvs);
+}
+
 void test_rvstr(void) {
     RUN_TEST(test_rvstr_basic);
+    RUN_TEST(test_rvstr_deque);
+    RUN_TEST(test_rvstr_cut);
+    RUN_TEST(test_rvstr_emplace);
+    RUN_TEST(test_rvstr_adopt);
+    RUN_TEST(test_rvstr_retain);
+    RUN_TEST(test_rvstr_swap_remove);
+}
+
+void test_srvstr_push_n(void) {
+    SRVStr rvs = {0};
+    Str strs[100] = {0};
+    for(size_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(0, str_fmt(&strs[i], "%u", i));
+    }
+    /* all bodies come from a single slab */
+    TEST_ASSERT_EQUAL(0, srvstr_push_back_n(&rvs, strs, 100));
+    TEST_ASSERT_NOT_NULL(rvs.slabs);
+    TEST_ASSERT_NULL(rvs.slabs->next);
+    TEST_ASSERT_EQUAL(100, srvstr_length(&rvs));
+    for(size_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(i, atoi(srvstr_get_at(&rvs, i)->s));
+    }
+    /* the vector owns the copies now */
+    srvstr_free(&rvs);
+}
+
+void test_srvstr(void) {
+    RUN_TEST(test_srvstr_basic);
+    RUN_TEST(test_srvstr_push_n);
+}
+
+void test_ustr(void) {
+    RUN_TEST(test_ustr_zero_end);
+}
+
+void test_vstr_deque(void) {
+    VStr vs = {0};
+    size_t n = 1000;
+    for(size_t i = 0; i < n; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, vstr_push_front(&vs, str));
+        /* pop some again, so that their room gets reused */
+        if(i % 3 == 2) vstr_pop_front(&vs, 0);
+    }
+    size_t len = vstr_length(&vs);
+    for(size_t i = 0; i < len; i++) {
+        Str str = vstr_get_at(&vs, len - 1 - i);
+        TEST_ASSERT_EQUAL(i + i / 2, atoi(str.s));
+    }
+    vstr_free(&vs);
+}
+
+void test_vstr_cut(void) {
+    VStr a = {0}, b = {0};
+    for(size_t i = 0; i < 100; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, vstr_push_back(&a, str));
+    }
+    /* moved items are owned by b only, freeing both must not double free */
+    TEST_ASSERT_EQUAL(0, vstr_cut_at(&a, 10, 20, &b));
+    TEST_ASSERT_EQUAL(0, vstr_cut_front(&a, &b, 5));
+    TEST_ASSERT_EQUAL(0, vstr_cut_back(&a, &b, 5));
+    TEST_ASSERT_EQUAL(70, vstr_length(&a));
+    TEST_ASSERT_EQUAL(30, vstr_length(&b));
+    TEST_ASSERT_EQUAL(5, atoi(vstr_get_at(&a, 0).s));
+    TEST_ASSERT_EQUAL(30, atoi(vstr_get_at(&a, 5).s));
+    TEST_ASSERT_EQUAL(10, atoi(vstr_get_at(&b, 0).s));
+    TEST_ASSERT_EQUAL(99, atoi(vstr_get_back(&b).s));
+    /* reusing the vacated slots */
+    for(size_t i = 0; i < 50; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, vstr_push_back(&a, str));
+    }
+    vstr_free(&a);
+    vstr_free(&b);
+}
+
+void test_vstr_emplace(void) {
+    VStr vs = {0};
+    for(size_t i = 0; i < 10; i++) {
+        Str *str = vstr_emplace_back(&vs);
+        TEST_ASSERT_NOT_NULL(str);
+        TEST_ASSERT_EQUAL(0, str_fmt(str, "%u", i));
+    }
+    /* the popped slot gets freed before it's handed out again */
+    vstr_pop_back(&vs, 0);
+    Str *back = vstr_emplace_back(&vs);
+    TEST_ASSERT_NULL(back->s);
+    TEST_ASSERT_EQUAL(0, str_fmt(back, "%s", "back"));
+    TEST_ASSERT_EQUAL(0, str_fmt(vstr_emplace_front(&vs), "%s", "front"));
+    TEST_ASSERT_EQUAL(0, str_fmt(vstr_emplace_at(&vs, 5), "%s", "middle"));
+    TEST_ASSERT_EQUAL(12, vstr_length(&vs));
+    TEST_ASSERT_EQUAL_STRING("front", vstr_get_at(&vs, 0).s);
+    TEST_ASSERT_EQUAL_STRING("3", vstr_get_at(&vs, 4).s);
+    TEST_ASSERT_EQUAL_STRING("middle", vstr_get_at(&vs, 5).s);
+    TEST_ASSERT_EQUAL_STRING("4", vstr_get_at(&vs, 6).s);
+    TEST_ASSERT_EQUAL_STRING("back", vstr_get_back(&vs).s);
+    vstr_free(&vs);
+}
+
+void test_vstr_detach(void) {
+    VStr a = {0}, b = {0};
+    for(size_t i = 0; i < 10; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, vstr_push_back(&a, str));
+    }
+    /* popped strings stay with the vector and get freed */
+    vstr_pop_back(&a, 0);
+    vstr_pop_front(&a, 0);
+    size_t len = 0;
+    Str *strs = vstr_detach(&a, &len);
+    TEST_ASSERT_EQUAL(8, len);
+    TEST_ASSERT_EQUAL_STRING("1", strs[0].s);
+    TEST_ASSERT_EQUAL_STRING("8", strs[7].s);
+    TEST_ASSERT_EQUAL(0, vstr_adopt(&b, strs, len, len));
+    TEST_ASSERT_EQUAL(8, vstr_length(&b));
+    TEST_ASSERT_EQUAL_STRING("8", vstr_get_back(&b).s);
+    vstr_move(&a, &b);
+    TEST_ASSERT_EQUAL(8, vstr_length(&a));
+    vstr_free(&a);
+    vstr_free(&b);
+}
+
+static int str_keep_even(const Str *str, void *ctx)
+{
+    (void) ctx;
+    return atoi(str->s) % 2 == 0;
+}
+
+void test_vstr_retain(void) {
+    VStr vs = {0};
+    for(size_t i = 0; i < 100; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, vstr_push_back(&vs, str));
+    }
+    /* every removed string gets freed exactly once */
+    TEST_ASSERT_EQUAL(50, vstr_retain(&vs, str_keep_even, 0));
+    vstr_erase_range(&vs, 10, 30);
+    vstr_erase_range(&vs, 0, 5);
+    TEST_ASSERT_EQUAL(15, vstr_length(&vs));
+    TEST_ASSERT_EQUAL(10, atoi(vstr_get_at(&vs, 0).s));
+    TEST_ASSERT_EQUAL(18, atoi(vstr_get_at(&vs, 4).s));
+    TEST_ASSERT_EQUAL(80, atoi(vstr_get_at(&vs, 5).s));
+    TEST_ASSERT_EQUAL(98, atoi(vstr_get_back(&vs).s));
+    for(size_t i = 0; i < 50; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, vstr_push_back(&vs, str));
+    }
+    vstr_free(&vs);
 }
 
 void test_vstr(void) {
     RUN_TEST(test_vstr_basic);
+    RUN_TEST(test_vstr_deque);
+    RUN_TEST(test_vstr_cut);
+    RUN_TEST(test_vstr_emplace);
+    RUN_TEST(test_vstr_detach);
+    RUN_TEST(test_vstr_retain);
+}
+
+void test_vu16_reverse(void)
+{
+    Vu16 v = {0};
+    for(size_t i = 0; i < 1001; i++) TEST_ASSERT_EQUAL(0, vu16_push_back(&v, i));
+    vu16_pop_front(&v, 0);
+    vu16_reverse(&v);
+    for(size_t i = 0; i < 1000; i++) TEST_ASSERT_EQUAL(1000 - i, vu16_get_at(&v, i));
+    vu16_free(&v);
+}
+
+void test_vu64_reverse(void)
+{
+    Vu64 v = {0};
+    for(size_t i = 0; i < 99; i++) TEST_ASSERT_EQUAL(0, vu64_push_back(&v, (uint64_t)i << 32 | i));
+    vu64_reverse_slice(&v, 1, 97);
+    TEST_ASSERT_EQUAL(0, vu64_get_front(&v));
+    TEST_ASSERT_EQUAL((uint64_t)98 << 32 | 98, vu64_get_back(&v));
+    for(size_t i = 1; i < 98; i++) TEST_ASSERT_EQUAL((uint64_t)(98 - i) << 32 | (98 - i), vu64_get_at(&v, i));
+    vu64_free(&v);
+}
+
+void test_vstr_reverse(void)
+{
+    /* no kernel for the size, swapped one by one */
+    VStr vs = {0};
+    for(size_t i = 0; i < 11; i++) {
+        Str str = {0};
+        TEST_ASSERT_EQUAL(0, str_fmt(&str, "%u", i));
+        TEST_ASSERT_EQUAL(0, vstr_push_back(&vs, str));
+    }
+    vstr_reverse_slice(&vs, 2, 8);
+    vstr_reverse(&vs);
+    size_t expect[] = {10, 2, 3, 4, 5, 6, 7, 8, 9, 1, 0};
+    for(size_t i = 0; i < 11; i++) TEST_ASSERT_EQUAL(expect[i], atoi(vstr_get_at(&vs, i).s));
+    vstr_free(&vs);
+}
+
+/* reverse slices of every length up to a few blocks of 32 bytes (and the 64 bytes a round of the
+ * AVX2 kernel takes), at aligned and unaligned starts, leaving odd items for the scalar middle */
+#define TEST_REVERSE_BLOCKS(N, A, T) \
+    do { \
+        N v = {0}; \
+        size_t max = 160 / sizeof(T); \
+        for(size_t from = 0; from < 4; from++) { \
+            for(size_t n = 0; n <= max; n++) { \
+                A##_clear(&v); \
+                for(size_t i = 0; i < from + n + 3; i++) TEST_ASSERT_EQUAL(0, A##_push_back(&v, (T)(i * 0x0101010101010101ULL + i))); \
+                A##_reverse_slice(&v, from, n); \
+                for(size_t i = 0; i < from + n + 3; i++) { \
+                    size_t j = i < from || i >= from + n ? i : from + n - 1 - (i - from); \
+                    TEST_ASSERT_TRUE(A##_get_at(&v, i) == (T)(j * 0x0101010101010101ULL + j)); \
+                } \
+            } \
+        } \
+        A##_free(&v); \
+    } while(0)
+
+void test_reverse_blocks(void)
+{
+    TEST_REVERSE_BLOCKS(Vu8, vu8, uint8_t);
+    TEST_REVERSE_BLOCKS(Vu16, vu16, uint16_t);
+    TEST_REVERSE_BLOCKS(Vu32, vu32, uint32_t);
+    TEST_REVERSE_BLOCKS(Vu64, vu64, uint64_t);
+}
+
+void test_reverse(void) {
+    RUN_TEST(test_vu16_reverse);
+    RUN_TEST(test_vu64_reverse);
+    RUN_TEST(test_vstr_reverse);
+    RUN_TEST(test_reverse_blocks);
 }
 
 // not needed when using generate_test_runner.rb
@@ -242,6 +1744,22 @@ int main(void) {
     test_rvu8();
     test_vstr();
     test_rvstr();
+    test_srvstr();
+    test_growth();
+    test_ustr();
+    test_ivu32();
+    test_avi16();
+    test_hvu64();
+    test_lvu32();
+    test_svu32();
+    test_ring();
+    test_qvu32();
+    test_qu64();
+    test_mu64();
+    test_seg();
+    test_gap();
+    test_rope();
+    test_reverse();
     return UNITY_END();
 }
 
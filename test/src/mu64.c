@@ -0,0 +1,4 @@
+#include "mu64.h"
+
+VEC_MPMC_IMPLEMENT(Mu64, mu64, uint64_t);
+
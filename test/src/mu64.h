@@ -0,0 +1,9 @@
+#ifndef MU64_H
+#include <stdint.h>
+#include "vec_mpmc.h"
+
+VEC_MPMC_INCLUDE(Mu64, mu64, uint64_t);
+
+#define MU64_H
+#endif
+
@@ -0,0 +1,6 @@
+#include "mvu64.h"
+
+#define VEC_SETTINGS_MREMAP_THRESHOLD 0x10000
+
+VEC_IMPLEMENT(MVu64, mvu64, uint64_t, BY_VAL, 0);
+
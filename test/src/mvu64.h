@@ -0,0 +1,15 @@
+#ifndef MVU64_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_MREMAP_THRESHOLD 0x10000
+
+#include "vec.h"
+VEC_INCLUDE(MVu64, mvu64, uint64_t, BY_VAL);
+
+#undef VEC_SETTINGS_MREMAP_THRESHOLD
+
+#define MVU64_H
+#endif
+
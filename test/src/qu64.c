@@ -0,0 +1,4 @@
+#include "qu64.h"
+
+VEC_SPSC_IMPLEMENT(Qu64, qu64, uint64_t);
+
@@ -0,0 +1,9 @@
+#ifndef QU64_H
+#include <stdint.h>
+#include "vec_spsc.h"
+
+VEC_SPSC_INCLUDE(Qu64, qu64, uint64_t);
+
+#define QU64_H
+#endif
+
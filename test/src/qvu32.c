@@ -0,0 +1,6 @@
+#include "qvu32.h"
+
+#define VEC_SETTINGS_COMPACT_FRONT 2
+
+VEC_IMPLEMENT(QVu32, qvu32, uint32_t, BY_VAL, 0);
+
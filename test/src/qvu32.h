@@ -0,0 +1,15 @@
+#ifndef QVU32_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_COMPACT_FRONT 2
+
+#include "vec.h"
+VEC_INCLUDE(QVu32, qvu32, uint32_t, BY_VAL);
+
+#undef VEC_SETTINGS_COMPACT_FRONT
+
+#define QVU32_H
+#endif
+
@@ -0,0 +1,35 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "ropestr.h"
+
+#define VEC_SETTINGS_DEFAULT_SIZE STR_DEFAULT_SIZE
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#define VEC_SETTINGS_STRUCT_ITEMS s
+
+VEC_ROPE_IMPLEMENT(RopeStr, ropestr, char, Str, str);
+
+/* other functions */
+
+int ropestr_fmt(RopeStr *rope, char *format, ...)
+{
+    if(!rope) return -1;
+    if(!format) return -1;
+    // format into a buffer of its own, only the new part gets copied into the rope
+    va_list argp;
+    va_start(argp, format);
+    int len_app = vsnprintf(0, 0, format, argp);
+    va_end(argp);
+    if(len_app < 0) return -1;
+    char small[256];
+    char *buf = (size_t)len_app < sizeof(small) ? small : malloc((size_t)len_app + 1);
+    if(!buf) return -1;
+    va_start(argp, format);
+    int len_chng = vsnprintf(buf, (size_t)len_app + 1, format, argp);
+    va_end(argp);
+    int result = len_chng == len_app ? ropestr_append_n(rope, buf, (size_t)len_app) : -1;
+    if(buf != small) free(buf);
+    return result;
+}
+
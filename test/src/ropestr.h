@@ -0,0 +1,25 @@
+#ifndef ROPESTR_H
+
+#include "str.h"
+
+/* configuration, inclusion and de-configuration of rope, same as Str */
+
+#define VEC_SETTINGS_DEFAULT_SIZE STR_DEFAULT_SIZE
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#define VEC_SETTINGS_STRUCT_ITEMS s
+
+#include "vec.h"
+#include "vec_rope.h"
+VEC_ROPE_INCLUDE(RopeStr, ropestr, char, Str);
+
+#undef VEC_SETTINGS_STRUCT_ITEMS
+#undef VEC_SETTINGS_KEEP_ZERO_END
+#undef VEC_SETTINGS_DEFAULT_SIZE
+
+/* other functions */
+
+int ropestr_fmt(RopeStr *rope, char *format, ...);
+
+#define ROPESTR_H
+#endif
+
@@ -0,0 +1,4 @@
+#include "rstr.h"
+
+VEC_RING_IMPLEMENT(RStr, rstr, Str, str_free);
+
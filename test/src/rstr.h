@@ -0,0 +1,10 @@
+#ifndef RSTR_H
+
+#include "str.h"
+
+#include "vec_ring.h"
+VEC_RING_INCLUDE(RStr, rstr, Str);
+
+#define RSTR_H
+#endif
+
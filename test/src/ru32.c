@@ -0,0 +1,4 @@
+#include "ru32.h"
+
+VEC_RING_IMPLEMENT(Ru32, ru32, uint32_t, 0);
+
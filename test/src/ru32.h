@@ -0,0 +1,9 @@
+#ifndef RU32_H
+#include <stdint.h>
+#include "vec_ring.h"
+
+VEC_RING_INCLUDE(Ru32, ru32, uint32_t);
+
+#define RU32_H
+#endif
+
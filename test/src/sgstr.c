@@ -0,0 +1,4 @@
+#include "sgstr.h"
+
+VEC_SEG_IMPLEMENT(SgStr, sgstr, Str, str_free);
+
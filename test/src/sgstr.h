@@ -0,0 +1,10 @@
+#ifndef SGSTR_H
+
+#include "str.h"
+
+#include "vec_seg.h"
+VEC_SEG_INCLUDE(SgStr, sgstr, Str);
+
+#define SGSTR_H
+#endif
+
@@ -0,0 +1,6 @@
+#include "sgu32.h"
+
+#define VEC_SETTINGS_SEG_BASE 4
+
+VEC_SEG_IMPLEMENT(Sgu32, sgu32, uint32_t, 0);
+
@@ -0,0 +1,15 @@
+#ifndef SGU32_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of segmented vector */
+
+#define VEC_SETTINGS_SEG_BASE 4
+
+#include "vec_seg.h"
+VEC_SEG_INCLUDE(Sgu32, sgu32, uint32_t);
+
+#undef VEC_SETTINGS_SEG_BASE
+
+#define SGU32_H
+#endif
+
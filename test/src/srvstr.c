@@ -0,0 +1,6 @@
+#include "srvstr.h"
+
+#define VEC_SETTINGS_SLAB 1
+
+VEC_IMPLEMENT(SRVStr, srvstr, Str, BY_REF, str_free);
+
@@ -0,0 +1,16 @@
+#ifndef SRVSTR_H
+
+#include "str.h"
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_SLAB 1
+
+#include "vec.h"
+VEC_INCLUDE(SRVStr, srvstr, Str, BY_REF);
+
+#undef VEC_SETTINGS_SLAB
+
+#define SRVSTR_H
+#endif
+
@@ -0,0 +1,6 @@
+#include "svu32.h"
+
+#define VEC_SETTINGS_STATS 1
+
+VEC_IMPLEMENT(SVu32, svu32, uint32_t, BY_VAL, 0);
+
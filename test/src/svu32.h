@@ -0,0 +1,15 @@
+#ifndef SVU32_H
+#include <stdint.h>
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_STATS 1
+
+#include "vec.h"
+VEC_INCLUDE(SVu32, svu32, uint32_t, BY_VAL);
+
+#undef VEC_SETTINGS_STATS
+
+#define SVU32_H
+#endif
+
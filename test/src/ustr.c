@@ -0,0 +1,8 @@
+#include "ustr.h"
+
+#define VEC_SETTINGS_ZERO_INIT 0
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#define VEC_SETTINGS_STRUCT_ITEMS s
+
+VEC_IMPLEMENT(UStr, ustr, char, BY_VAL, 0);
+
@@ -0,0 +1,18 @@
+#ifndef USTR_H
+
+/* configuration, inclusion and de-configuration of vector */
+
+#define VEC_SETTINGS_ZERO_INIT 0
+#define VEC_SETTINGS_KEEP_ZERO_END 1
+#define VEC_SETTINGS_STRUCT_ITEMS s
+
+#include "vec.h"
+VEC_INCLUDE(UStr, ustr, char, BY_VAL);
+
+#undef VEC_SETTINGS_STRUCT_ITEMS
+#undef VEC_SETTINGS_KEEP_ZERO_END
+#undef VEC_SETTINGS_ZERO_INIT
+
+#define USTR_H
+#endif
+